@@ -0,0 +1,31 @@
+#!/bin/sh
+# Escalabilidade pelo modelo de Amdahl: roda a mesma entrada com 1..N CPUs e mostra
+# o turnaround (médio e máximo, que é o makespan com todas as chegadas em 0)
+# Uso: bench/amdahl_scaling.sh entrada.txt [N] [opções chave=valor ...]
+#      ex.: bench/amdahl_scaling.sh teste_amdahl.txt 8 serial=25
+# Requer o binário ./trabSO compilado com make multiprocessador
+
+. "$(dirname "$0")/common.sh"
+
+bench_usage "entrada.txt [N] [opcoes ...]" $#
+input=$1
+shift
+max_cpus=4
+if [ $# -gt 0 ]; then
+    max_cpus=$1
+    shift
+fi
+
+bench_header "%-6s %14s %14s %16s" "cpus" "turnaround" "makespan" "speedup_medio"
+cpus=1
+while [ "$cpus" -le "$max_cpus" ]; do
+    if ! bench_run "$input" amdahl=1 "cpus=$cpus" "$@"; then
+        bench_error_row "$cpus"
+    else
+        bench_row "$cpus" \
+            "$(bench_field '^Turnaround: media \([0-9.]*\) ms.*')" \
+            "$(bench_field '^Turnaround: .*max \([0-9]*\) ms.*')" \
+            "$(bench_field '^Progresso paralelo.*media \([0-9.]*\) |.*')"
+    fi
+    cpus=$((cpus + 1))
+done
@@ -0,0 +1,28 @@
+#!/bin/sh
+# CPUs heterogêneas: roda a mesma entrada com a colocação que ignora as
+# capacidades (capacity_aware=0) e com a colocação ciente (capacity_aware=1)
+# e mostra makespan, turnaround médio e migrações de pesados
+# Uso: bench/capacity_compare.sh entrada.txt [opções chave=valor ...]
+#      ex.: bench/capacity_compare.sh teste_biglittle.txt policy=RR misfit=1500
+# A entrada (ou as opções) deve trazer capacity=; requer ./trabSO compilado
+# com make multiprocessador
+
+. "$(dirname "$0")/common.sh"
+
+bench_usage "entrada.txt [opcoes ...]" $#
+input=$1
+shift
+
+bench_header "%-12s %12s %14s %10s" "colocacao" "makespan" "turnaround" "misfits"
+for aware in 0 1; do
+    label=indiferente
+    [ $aware -eq 1 ] && label=ciente
+    if ! bench_run "$input" "$@" "capacity_aware=$aware"; then
+        bench_error_row "$label"
+        continue
+    fi
+    bench_row "$label" \
+        "$(bench_field '^Capacidades.*makespan \([0-9]*\) ms.*')" \
+        "$(bench_field '^Capacidades.*turnaround medio \([0-9.]*\) ms.*')" \
+        "$(bench_field '^Capacidades.* \([0-9]*\) migracoes de pesados.*')"
+done
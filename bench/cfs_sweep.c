@@ -0,0 +1,148 @@
+/**
+ * Benchmark de varredura dos parâmetros do CFS
+ * Executa o código real de src/cfs.c em tempo virtual (passos de 1ms, sem os
+ * blocos de 500ms das threads) e mede, para cada combinação de sched_latency,
+ * min_granularity e número de processos executáveis, a taxa de trocas de
+ * contexto e o tempo de resposta.
+ *
+ * Uso: make bench && ./bench/cfs_sweep
+ */
+#include "structures.h"
+#include "cfs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+SystemState system_state;
+
+typedef struct {
+    long switches;          // Despachos realizados
+    long makespan_ms;       // Instante em que o último processo terminou
+    double mean_response;   // Média de (primeiro despacho - chegada)
+    long p99_response;      // Cauda do tempo de resposta
+} SweepResult;
+
+static int compare_long(const void* a, const void* b) {
+    long x = *(const long*)a;
+    long y = *(const long*)b;
+    return (x > y) - (x < y);
+}
+
+/* Carga sintética reprodutível: chegadas nos primeiros 200ms, 20..400ms de CPU */
+static void build_workload(PCB* pcbs, int count, unsigned seed) {
+    srand(seed);
+    for (int i = 0; i < count; i++) {
+        PCB* pcb = &pcbs[i];
+        memset(pcb, 0, sizeof(PCB));
+        pcb->pid = i + 1;
+        pcb->priority = 1 + rand() % 5;
+        pcb->process_len = 20 + rand() % 381;
+        pcb->remaining_time = pcb->process_len;
+        pcb->runtime_snapshot = pcb->process_len;
+        pcb->start_time = rand() % 200;
+        pcb->cfs_quota_ms = -1;
+        pcb->first_run_ms = -1;
+        pcb->finish_ms = -1;
+        pthread_mutex_init(&pcb->mutex, NULL);
+    }
+}
+
+static SweepResult run_sweep_point(int count, int latency_us, int min_gran_us) {
+    PCB* pcbs = malloc(count * sizeof(PCB));
+    long* responses = malloc(count * sizeof(long));
+    SweepResult result = {0, 0, 0.0, 0};
+    
+    system_state.tunables.sched_latency_us = latency_us;
+    system_state.tunables.sched_min_granularity_us = min_gran_us;
+    build_workload(pcbs, count, 42);
+    cfs_init();
+    
+    int arrived = 0;
+    int finished = 0;
+    long now = 0;
+    PCB* curr = NULL;
+    
+    while (finished < count) {
+        // Chegadas neste instante (wakeups)
+        bool woken = false;
+        for (int i = 0; i < count; i++) {
+            if (pcbs[i].start_time == now) {
+                cfs_enqueue_process(&pcbs[i]);
+                arrived++;
+                woken = true;
+            }
+        }
+        if (curr && woken && cfs_check_preempt_wakeup(curr)) {
+            cfs_put_prev_process(curr, 0);
+            curr = NULL;
+        }
+        
+        if (!curr) {
+            curr = cfs_pick_next();
+            if (curr) {
+                result.switches++;
+                if (curr->first_run_ms < 0) {
+                    curr->first_run_ms = now;
+                }
+            }
+        }
+        
+        // Executa 1ms de CPU
+        now++;
+        if (!curr) continue;
+        curr->remaining_time--;
+        cfs_charge_runtime(curr, now);
+        
+        if (curr->remaining_time == 0) {
+            curr->finish_ms = now;
+            finished++;
+            curr = NULL;
+        } else if (cfs_slice_expired(curr, 0)) {
+            cfs_put_prev_process(curr, 0);
+            curr = NULL;
+        }
+    }
+    
+    double sum = 0;
+    for (int i = 0; i < count; i++) {
+        responses[i] = pcbs[i].first_run_ms - pcbs[i].start_time;
+        sum += responses[i];
+        pthread_mutex_destroy(&pcbs[i].mutex);
+    }
+    qsort(responses, count, sizeof(long), compare_long);
+    result.makespan_ms = now;
+    result.mean_response = sum / count;
+    result.p99_response = responses[(99 * count + 99) / 100 - 1];
+    
+    cfs_cleanup();
+    free(responses);
+    free(pcbs);
+    return result;
+}
+
+int main(void) {
+    const int counts[] = {8, 64, 256};
+    const int latencies_us[] = {6000, 20000, 48000};
+    const int min_grans_us[] = {750, 1000, 4000};
+    
+    for (int g = 0; g <= MAX_CGROUPS; g++) {
+        system_state.tunables.cgroup_quota_ms[g] = -1;
+    }
+    system_state.tunables.cfs_period_ms = 100;
+    system_state.tunables.cfs_quota_ms = -1;
+    system_state.tunables.sched_wakeup_granularity_us = 1000;
+    
+    printf("%6s %10s %10s %12s %12s %12s\n",
+           "procs", "latency_us", "min_gran_us", "trocas/s", "resp_media", "resp_p99");
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        for (size_t l = 0; l < sizeof(latencies_us) / sizeof(latencies_us[0]); l++) {
+            for (size_t m = 0; m < sizeof(min_grans_us) / sizeof(min_grans_us[0]); m++) {
+                SweepResult r = run_sweep_point(counts[c], latencies_us[l], min_grans_us[m]);
+                printf("%6d %10d %10d %12.1f %10.1fms %10ldms\n", counts[c], latencies_us[l],
+                       min_grans_us[m], r.switches * 1000.0 / r.makespan_ms,
+                       r.mean_response, r.p99_response);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+# Funções comuns dos scripts de bench/: cada script só define o laço de
+# parâmetros e as colunas da tabela
+# Uso: . "$(dirname "$0")/common.sh"
+# BIN=caminho/do/binario sobrescreve ./trabSO
+
+BIN=${BIN:-./trabSO}
+METRICS=metricas_minikernel.txt
+
+# Sai com a mensagem de uso se não houver argumentos
+# bench_usage "entrada.txt [opcoes ...]" $#
+bench_usage() {
+    if [ "$2" -eq 0 ]; then
+        echo "Uso: $0 $1" >&2
+        exit 1
+    fi
+}
+
+# Define o formato das linhas e imprime o cabeçalho
+# bench_header "%-8s %12s" coluna1 coluna2
+bench_header() {
+    BENCH_FORMAT="$1\n"
+    shift
+    BENCH_COLUMNS=$#
+    printf "$BENCH_FORMAT" "$@"
+}
+
+# Executa a simulação com os argumentos dados; falha se o binário falhar
+bench_run() {
+    "$BIN" "$@" >/dev/null 2>&1
+}
+
+# Campo das métricas da última execução: regex sed com um grupo \(...\)
+# bench_field '^Turnaround: media \([0-9.]*\) ms.*'
+bench_field() {
+    sed -n "s/$1/\\1/p" "$METRICS"
+}
+
+# Imprime uma linha; campos vazios (métrica ausente) viram "-"
+bench_row() {
+    for bench_value in "$@"; do
+        shift
+        set -- "$@" "${bench_value:--}"
+    done
+    printf "$BENCH_FORMAT" "$@"
+}
+
+# Linha de execução que falhou: rótulos dados, "erro" e "-" nas demais colunas
+# bench_error_row rotulo1 [rotulo2 ...]
+bench_error_row() {
+    set -- "$@" erro
+    while [ $# -lt "$BENCH_COLUMNS" ]; do
+        set -- "$@" -
+    done
+    printf "$BENCH_FORMAT" "$@"
+}
@@ -0,0 +1,27 @@
+#!/bin/sh
+# Compara o tempo médio de resposta e o turnaround de políticas nas mesmas entradas,
+# junto com a distância ao limite ótimo do SRTF ideal
+# Uso: bench/compare_policies.sh entrada.txt [entrada2.txt ...]
+#      POLICIES="RR MLFQ" bench/compare_policies.sh ...   (padrão: RR MLFQ)
+# Requer o binário ./trabSO já compilado (make monoprocessador ou multiprocessador)
+
+. "$(dirname "$0")/common.sh"
+
+POLICIES=${POLICIES:-"RR MLFQ"}
+
+bench_usage "entrada.txt [entrada2.txt ...]" $#
+
+bench_header "%-32s %-10s %14s %14s %14s %10s" "entrada" "politica" "resposta_media" "turnaround" "otimo_srtf" "distancia"
+for input in "$@"; do
+    for policy in $POLICIES; do
+        if ! bench_run "$input" "policy=$policy"; then
+            bench_error_row "$input" "$policy"
+            continue
+        fi
+        bench_row "$input" "$policy" \
+            "$(bench_field '^Tempo de resposta: media \([0-9.]*\) ms.*')" \
+            "$(bench_field '^Turnaround: media \([0-9.]*\) ms.*')" \
+            "$(bench_field '^Limite otimo (SRTF ideal): turnaround medio \([0-9.]*\) ms.*')" \
+            "$(bench_field '^Limite otimo.*distancia \([-+0-9.]*%\).*')"
+    done
+done
@@ -0,0 +1,27 @@
+#!/bin/sh
+# Recuperação depois de mudanças de capacidade: roda a mesma entrada com
+# hotplug (hotplug= na entrada ou nas opções) em várias políticas e mostra a
+# recuperação média dos eventos, a vazão e o turnaround médio
+# Uso: bench/hotplug_recovery.sh entrada.txt [opções chave=valor ...]
+#      POLICIES="RR CFS" bench/hotplug_recovery.sh teste_hotplug.txt   (padrão: FCFS RR CFS MLFQ)
+# Requer o binário ./trabSO já compilado com make multiprocessador
+
+. "$(dirname "$0")/common.sh"
+
+POLICIES=${POLICIES:-"FCFS RR CFS MLFQ"}
+
+bench_usage "entrada.txt [opcoes ...]" $#
+input=$1
+shift
+
+bench_header "%-10s %16s %12s %14s" "politica" "recuperacao_ms" "vazao" "turnaround"
+for policy in $POLICIES; do
+    if ! bench_run "$input" "policy=$policy" "$@"; then
+        bench_error_row "$policy"
+        continue
+    fi
+    bench_row "$policy" \
+        "$(bench_field '^Hotplug:.*recuperacao media \([0-9.]*\) ms.*')" \
+        "$(bench_field '^Hotplug:.*vazao \([0-9.]*\) processos.*')" \
+        "$(bench_field '^Turnaround: media \([0-9.]*\) ms.*')"
+done
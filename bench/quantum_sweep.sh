@@ -0,0 +1,34 @@
+#!/bin/sh
+# Escolha do quantum do RR com custo de troca: roda a mesma entrada com quanta
+# crescentes e mostra a fração da CPU perdida em trocas, a vazão e o turnaround
+# Uso: bench/quantum_sweep.sh entrada.txt [quanta] [opções chave=valor ...]
+#      ex.: bench/quantum_sweep.sh teste_io.txt "500 1000 2000 4000" cs_cost=50 migration_cost=100
+# Quanta são múltiplos de 500 ms (um bloco de execução); padrão cs_cost=50
+# Requer o binário ./trabSO já compilado (make monoprocessador ou multiprocessador)
+
+. "$(dirname "$0")/common.sh"
+
+bench_usage "entrada.txt [quanta] [opcoes ...]" $#
+input=$1
+shift
+quanta="500 1000 1500 2000 3000"
+if [ $# -gt 0 ]; then
+    quanta=$1
+    shift
+fi
+if [ $# -eq 0 ]; then
+    set -- cs_cost=50
+fi
+
+bench_header "%-8s %12s %12s %12s %14s" "quantum" "despachos" "sobrecarga" "vazao" "turnaround"
+for quantum in $quanta; do
+    if ! bench_run "$input" policy=RR "rr_quantum=$quantum" "$@"; then
+        bench_error_row "$quantum"
+        continue
+    fi
+    bench_row "$quantum" \
+        "$(bench_field '^Despachos (trocas de contexto): \([0-9]*\).*')" \
+        "$(bench_field '^Sobrecarga de trocas.*CPU, \([0-9.]*%\) do tempo.*')" \
+        "$(bench_field '^Sobrecarga de trocas.*vazao \([0-9.]*\) processos.*')" \
+        "$(bench_field '^Turnaround: media \([0-9.]*\) ms.*')"
+done
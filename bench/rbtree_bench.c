@@ -0,0 +1,184 @@
+/**
+ * Microbenchmark da Red-Black Tree intrusiva
+ * Compara a inserção com comparador via ponteiro de função (rb_insert)
+ * com a inserção gerada por RB_DEFINE_INSERT (comparação embutida).
+ * Cada rodada insere N chaves aleatórias e depois esvazia a árvore pelo
+ * menor elemento (padrão de uso do CFS: insert + pick_next/erase).
+ * Em seguida confere os agregados (tamanho e peso das subárvores) após
+ * inserções e remoções arbitrárias e compara as consultas de estatística
+ * de ordem O(log n) com a varredura em ordem O(n).
+ *
+ * Uso: make bench && ./bench/rbtree_bench [N] [rodadas]
+ */
+#define _GNU_SOURCE
+#include "rbtree.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct {
+    long long key;
+    RBNode node;
+} BenchItem;
+
+static int item_compare(const RBNode* a, const RBNode* b) {
+    long long ka = rb_entry(a, BenchItem, node)->key;
+    long long kb = rb_entry(b, BenchItem, node)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+static inline bool item_less(const BenchItem* a, const BenchItem* b) {
+    return a->key < b->key;
+}
+
+RB_DEFINE_INSERT(item_insert_inline, BenchItem, node, item_less)
+
+static double elapsed_ms(const struct timespec* start, const struct timespec* end) {
+    return (end->tv_sec - start->tv_sec) * 1000.0 + (end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+/* Esvazia a árvore pelo menor nó, conferindo a ordem crescente */
+static int drain_in_order(RBRoot* root) {
+    long long last = -1;
+    int ordered = 1;
+    while (!rb_is_empty(root)) {
+        RBNode* node = rb_leftmost(root);
+        long long key = rb_entry(node, BenchItem, node)->key;
+        if (key < last) ordered = 0;
+        last = key;
+        rb_remove(root, node);
+    }
+    return ordered;
+}
+
+/* Confere recursivamente tamanho e peso de cada subárvore; retorna o tamanho ou -1 */
+static int check_augment(const RBNode* node, long long* weight) {
+    if (!node) {
+        *weight = 0;
+        return 0;
+    }
+    long long wl, wr;
+    int sl = check_augment(node->rb_left, &wl);
+    int sr = check_augment(node->rb_right, &wr);
+    if (sl < 0 || sr < 0) return -1;
+    *weight = wl + wr + node->rb_weight;
+    if (node->rb_size != sl + sr + 1 || node->rb_subtree_weight != *weight) return -1;
+    return node->rb_size;
+}
+
+/* Posição por varredura a partir do menor nó (referência O(n)) */
+static int linear_rank(const RBRoot* root, const RBNode* target) {
+    int rank = 0;
+    for (RBNode* node = rb_leftmost(root); node && node != target; node = rb_next(node)) {
+        rank++;
+    }
+    return rank;
+}
+
+/* Mediana ponderada por varredura (referência O(n)) */
+static RBNode* linear_weighted(const RBRoot* root, long long target) {
+    for (RBNode* node = rb_leftmost(root); node; node = rb_next(node)) {
+        if (target < node->rb_weight) return node;
+        target -= node->rb_weight;
+    }
+    return NULL;
+}
+
+/* Remove metade dos nós fora de ordem, confere agregados e mede as consultas */
+static int bench_order_statistics(BenchItem* items, int count) {
+    RBRoot root = RB_ROOT_INIT;
+    long long weight;
+    for (int i = 0; i < count; i++) {
+        items[i].node.rb_weight = items[i].key % 100 + 1;
+        item_insert_inline(&root, &items[i]);
+    }
+    for (int i = 0; i < count; i += 2) {
+        rb_remove(&root, &items[i].node);
+    }
+    int ok = check_augment(root.rb_node, &weight) == rb_count_nodes(&root) &&
+             weight == rb_total_weight(&root);
+    
+    int queries = count < 2000 ? count : 2000;
+    int probes = queries / 4 > 0 ? queries / 4 : 1;
+    struct timespec t0, t1, t2;
+    
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int q = 0; q < queries; q++) {
+        BenchItem* item = &items[2 * (q % (count / 2)) + 1];
+        int k = rb_rank(&item->node);
+        if (rb_select(&root, k) != &item->node) ok = 0;
+        if (rb_select_by_weight(&root, rb_total_weight(&root) * q / queries) == NULL) ok = 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    for (int q = 0; q < probes; q++) {
+        BenchItem* item = &items[2 * (q % (count / 2)) + 1];
+        if (linear_rank(&root, &item->node) != rb_rank(&item->node)) ok = 0;
+        long long target = rb_total_weight(&root) * q / probes;
+        if (linear_weighted(&root, target) != rb_select_by_weight(&root, target)) ok = 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t2);
+    
+    printf("agregados apos remocoes: %s (%d nos, peso %lld)\n", ok ? "ok" : "INVALIDOS",
+           rb_count_nodes(&root), rb_total_weight(&root));
+    printf("%-22s %12s\n", "consulta", "ns/op");
+    printf("%-22s %12.1f\n", "rank+select O(log n)", elapsed_ms(&t0, &t1) * 1e6 / queries);
+    printf("%-22s %12.1f\n", "varredura O(n)", elapsed_ms(&t1, &t2) * 1e6 / probes);
+    
+    while (!rb_is_empty(&root)) rb_remove(&root, rb_leftmost(&root));
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 100000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 20;
+    if (count < 2 || rounds <= 0) {
+        fprintf(stderr, "Uso: %s [N] [rodadas]\n", argv[0]);
+        return 1;
+    }
+    
+    BenchItem* items = malloc(count * sizeof(BenchItem));
+    if (items == NULL) return 1;
+    srand(7);
+    for (int i = 0; i < count; i++) {
+        items[i].key = ((long long)rand() << 16) ^ rand();
+    }
+    
+    double fp_insert = 0, fp_erase = 0, inline_insert = 0, inline_erase = 0;
+    int ordered = 1;
+    struct timespec t0, t1, t2;
+    
+    for (int r = 0; r < rounds; r++) {
+        RBRoot root = RB_ROOT_INIT;
+        
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int i = 0; i < count; i++) {
+            rb_insert(&root, &items[i].node, item_compare);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ordered &= drain_in_order(&root);
+        clock_gettime(CLOCK_MONOTONIC, &t2);
+        fp_insert += elapsed_ms(&t0, &t1);
+        fp_erase += elapsed_ms(&t1, &t2);
+        
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (int i = 0; i < count; i++) {
+            item_insert_inline(&root, &items[i]);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        ordered &= drain_in_order(&root);
+        clock_gettime(CLOCK_MONOTONIC, &t2);
+        inline_insert += elapsed_ms(&t0, &t1);
+        inline_erase += elapsed_ms(&t1, &t2);
+    }
+    
+    printf("N=%d rodadas=%d ordem %s\n", count, rounds, ordered ? "ok" : "INVALIDA");
+    printf("%-22s %12s %12s\n", "variante", "insert ns/op", "erase ns/op");
+    double ops = (double)count * rounds;
+    printf("%-22s %12.1f %12.1f\n", "ponteiro de funcao", fp_insert * 1e6 / ops, fp_erase * 1e6 / ops);
+    printf("%-22s %12.1f %12.1f\n", "comparacao embutida", inline_insert * 1e6 / ops, inline_erase * 1e6 / ops);
+    
+    ordered &= bench_order_statistics(items, count);
+    
+    free(items);
+    return ordered ? 0 : 1;
+}
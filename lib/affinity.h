@@ -0,0 +1,87 @@
+#ifndef AFFINITY_H
+#define AFFINITY_H
+
+#include "structures.h"
+#include <stdbool.h>
+
+/**
+ * Afinidade de cache (affinity=1) e modelo de calor do cache
+ * O cache de um processo fica na CPU em que executou por último (last_cpu) e
+ * esfria linearmente com o tempo fora dela (cache_decay ms até esfriar de vez).
+ * Com afinidade, o despacho prefere a CPU quente; se ela está ocupada, o
+ * processo espera por ela enquanto o cache está acima de 50% e o desequilíbrio
+ * (CPUs livres) não passa de affinity_imbalance. Com topologia, a CPU livre
+ * escolhida é a mais próxima da anterior e o processo espera pela sua se o
+ * intervalo do domínio ainda não permite a migração.
+ */
+
+// Estatísticas de despacho com afinidade
+typedef struct {
+    int warm_dispatches;        // Despachos na CPU do despacho anterior
+    int migrations;             // Despachos em outra CPU
+    int holds;                  // Processos que esperaram pela CPU quente
+    long miss_ms;               // Penalidade de recarga de cache cobrada
+} AffinityStats;
+
+/**
+ * Reinicia o calor das CPUs, as esperas e as estatísticas
+ */
+void affinity_init(void);
+
+/**
+ * Registra a saída do processo de uma CPU (início do resfriamento)
+ * @param pcb Processo que saiu
+ * @param cpu CPU liberada
+ * @param now_ms Tempo atual
+ */
+void affinity_note_leave(PCB* pcb, int cpu, long now_ms);
+
+/**
+ * Calor do cache do processo em uma CPU (1 = quente, 0 = frio)
+ * @param pcb Processo
+ * @param last_cpu CPU em que o processo (ou a thread) executou por último
+ * @param cpu CPU do novo despacho
+ * @param now_ms Tempo atual
+ * @return Fração do cache ainda válida em cpu
+ */
+double cache_warmth(const PCB* pcb, int last_cpu, int cpu, long now_ms);
+
+/**
+ * Contabiliza um despacho com a penalidade de cache cobrada
+ * @param migrated true se a CPU difere da anterior
+ * @param miss_ms Penalidade de recarga cobrada
+ */
+void affinity_note_dispatch(bool migrated, int miss_ms);
+
+/**
+ * Processo que esperava pela CPU e deve ocupá-la agora: o que espera por
+ * essa CPU ou, se não há, um que desistiu da sua (cache frio ou desequilíbrio)
+ * @param cpu CPU livre
+ * @return Processo a despachar (NULL = nenhum)
+ */
+PCB* affinity_take_parked(int cpu);
+
+/**
+ * Escolhe a CPU do processo escolhido pela classe entre as livres
+ * A CPU quente se está livre; se ocupada, o processo pode ficar esperando por
+ * ela; senão, a CPU livre mais próxima na topologia (no mesmo nível, a que
+ * esfriou há mais tempo)
+ * @param pcb Processo escolhido pela classe
+ * @param free_cpu CPU livre percorrida pelo despacho
+ * @return CPU do despacho ou -1 se o processo ficou esperando pela CPU quente
+ */
+int affinity_select_cpu(PCB* pcb, int free_cpu);
+
+/**
+ * Verifica se há processos esperando pela CPU quente
+ * @return true se algum processo está fora da classe esperando
+ */
+bool affinity_has_parked(void);
+
+/**
+ * Obtém as estatísticas de afinidade
+ * @param out Estatísticas
+ */
+void affinity_get_stats(AffinityStats* out);
+
+#endif // AFFINITY_H
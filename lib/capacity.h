@@ -0,0 +1,73 @@
+#ifndef CAPACITY_H
+#define CAPACITY_H
+
+#include "structures.h"
+#include "sched_class.h"
+#include <stdbool.h>
+
+/**
+ * CPUs heterogêneas (big.LITTLE) e colocação ciente de capacidade
+ * capacity=C0,C1,... dá a capacidade de cada CPU em % (padrão 100): um bloco
+ * numa CPU de capacidade C desconta C% do trabalho. Com capacity_aware=1,
+ * jobs pesados (trabalho restante >= misfit ms) vão para a maior CPU livre e
+ * os leves para a menor; um pesado numa CPU pequena migra (misfit) quando
+ * uma CPU maior fica ociosa.
+ */
+
+// Colocação e migrações de tarefas desajustadas
+typedef struct {
+    int misfit_migrations;      // Pesados movidos para uma CPU maior
+    long big_ms;                // CPU x tempo ocupado nas CPUs de maior capacidade
+    long busy_ms;               // CPU x tempo ocupado em todas as CPUs
+} CapacityStats;
+
+/**
+ * Reinicia as estatísticas e registra as capacidades no log
+ */
+void capacity_init(void);
+
+/**
+ * Capacidade de uma CPU em %
+ * @param cpu CPU
+ * @return Capacidade (100 = CPU de referência)
+ */
+int capacity_of(int cpu);
+
+/**
+ * Verifica se as CPUs têm capacidades diferentes de 100%
+ * @return true se alguma CPU em uso tem outra capacidade
+ */
+bool capacity_enabled(void);
+
+/**
+ * Escolhe a CPU livre pela capacidade (apenas com capacity_aware=1)
+ * @param pcb Processo escolhido pela classe
+ * @param cpu CPU escolhida até aqui
+ * @return Maior CPU livre para pesados, menor para leves (empate mantém cpu)
+ */
+int capacity_select_cpu(const PCB* pcb, int cpu);
+
+/**
+ * Publica em cada processo em execução a capacidade média das suas CPUs
+ */
+void capacity_publish(void);
+
+/**
+ * Move pesados em execução de CPUs pequenas para CPUs maiores ociosas
+ * @param sched_class Classe em uso (classes gang não migram)
+ */
+void capacity_migrate_misfits(const SchedClass* sched_class);
+
+/**
+ * Contabiliza o intervalo desde a última chamada (uma por ciclo de despacho)
+ * @param now_ms Tempo atual
+ */
+void capacity_account(long now_ms);
+
+/**
+ * Obtém as estatísticas de capacidade
+ * @param out Estatísticas
+ */
+void capacity_get_stats(CapacityStats* out);
+
+#endif // CAPACITY_H
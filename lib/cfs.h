@@ -16,12 +16,26 @@ void cfs_init(void);
  */
 void cfs_enqueue_process(PCB* process);
 
+/**
+ * Retira processo da fila do CFS sem executá-lo (árvore ou lista de estrangulados)
+ * @param process Processo a ser retirado
+ */
+void cfs_dequeue_process(PCB* process);
+
 /**
  * Seleciona próximo processo para execução
  * @return Processo com menor vruntime ou NULL se não há processos
  */
 PCB* cfs_pick_next(void);
 
+/**
+ * Seleciona um processo específico fora da ordem de vruntime (ex.: SLO urgente)
+ * Retira da árvore e inicia a fatia como cfs_pick_next; processo estrangulado
+ * não está na árvore e não é retirado (ver cfs_is_throttled)
+ * @param process Processo escolhido pela classe
+ */
+void cfs_pick_process(PCB* process);
+
 /**
  * Reinsere processo após execução
  * @param process Processo que acabou de executar
@@ -30,18 +44,69 @@ PCB* cfs_pick_next(void);
 void cfs_put_prev_process(PCB* process, uint64_t runtime_ns);
 
 /**
- * Calcula timeslice para um processo
- * @param process Processo para calcular timeslice
+ * Verifica se o processo esgotou a fatia calculada no despacho
+ * @param process Processo em execução
+ * @param lookahead_ms Runtime já em andamento que ainda não foi contabilizado
+ *                     (permite preemptar na fronteira do bloco que fecha a fatia);
+ *                     se > 0, a fatia é contada em blocos inteiros dessa duração
+ *                     (0 = fatia exata, passos de tempo virtual)
+ * @return true se a fatia terminou e há outro processo aguardando
+ */
+bool cfs_slice_expired(PCB* process, int lookahead_ms);
+
+/**
+ * Verifica se um processo recém-chegado deve preemptar o atual
+ * Preempta quando o vruntime do atual excede o do mais à esquerda
+ * por mais que a granularidade de wakeup (ponderada pelo peso)
+ * @param curr Processo em execução (vruntime já atualizado)
+ * @return true se deve haver preempção
+ */
+bool cfs_check_preempt_wakeup(PCB* curr);
+
+/**
+ * Obtém o timeslice calculado no despacho (período / peso relativo)
+ * @param process Processo selecionado por cfs_pick_next
  * @return Timeslice em microssegundos
  */
 int cfs_get_timeslice(PCB* process);
 
 /**
- * Verifica se há processos na fila CFS
+ * Contabiliza o runtime consumido pelo processo desde a última chamada:
+ * avança o vruntime e a fatia atual e desconta da quota do pool de banda
+ * @param process Processo em execução
+ * @param now_ms Tempo atual da simulação em milissegundos
+ * @return true se o pool do processo está estrangulado (deve deixar a CPU)
+ */
+bool cfs_charge_runtime(PCB* process, long now_ms);
+
+/**
+ * Recarrega a quota dos pools cujo período venceu e devolve à árvore
+ * os processos estrangulados que voltaram a ter runtime
+ * @param now_ms Tempo atual da simulação em milissegundos
+ */
+void cfs_bandwidth_refresh(long now_ms);
+
+/**
+ * Obtém estatísticas de estrangulamento de um grupo de banda
+ * @param group Id do grupo (1..MAX_CGROUPS)
+ * @param nr_throttled Saída: número de estrangulamentos
+ * @param throttled_ms Saída: tempo total estrangulado
+ */
+void cfs_get_bandwidth_stats(int group, int* nr_throttled, long* throttled_ms);
+
+/**
+ * Verifica se há processos na fila CFS (incluindo os estrangulados)
  * @return true se há processos, false caso contrário
  */
 bool cfs_has_processes(void);
 
+/**
+ * Verifica se o pool de banda do processo está estrangulado
+ * @param process Processo
+ * @return true se o processo aguarda a recarga da quota
+ */
+bool cfs_is_throttled(const PCB* process);
+
 /**
  * Limpa e finaliza o sistema CFS
  */
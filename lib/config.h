@@ -0,0 +1,22 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include "structures.h"
+
+/**
+ * Preenche os parâmetros ajustáveis com os valores padrão
+ * @param tunables Estrutura a ser inicializada
+ */
+void init_default_tunables(SchedTunables* tunables);
+
+/**
+ * Aplica uma opção no formato chave=valor
+ * A opção pid=N seleciona o processo ao qual as opções por processo
+ * seguintes se aplicam; as demais ajustam system_state.tunables
+ * @param token Texto "chave=valor"
+ * @param scope Processo selecionado pela última opção pid=N (atualizado aqui)
+ * @return 1 se a opção é válida, 0 caso contrário
+ */
+int apply_config_option(const char* token, PCB** scope);
+
+#endif // CONFIG_H
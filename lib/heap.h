@@ -0,0 +1,76 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include "structures.h"
+#include <stdbool.h>
+
+/**
+ * Comparação de processos: true se a deve sair do heap antes de b
+ */
+typedef bool (*heap_less_func_t)(const PCB* a, const PCB* b);
+
+/**
+ * Min-heap binário de processos em vetor
+ * Cada PCB guarda sua posição (heap_index), permitindo remover um processo
+ * arbitrário em O(log n); um processo participa de no máximo um heap por vez
+ */
+typedef struct {
+    PCB** items;                // Vetor do heap (items[0] é o menor)
+    int size;                   // Processos no heap
+    int capacity;               // Capacidade alocada
+    heap_less_func_t less;      // Ordem do heap
+} ProcessHeap;
+
+/**
+ * Inicializa um heap vazio
+ * @param heap Heap a ser inicializado
+ * @param capacity Capacidade inicial (cresce sob demanda)
+ * @param less Ordem dos processos
+ * @return 1 se sucesso, 0 se falha de alocação
+ */
+int heap_init(ProcessHeap* heap, int capacity, heap_less_func_t less);
+
+/**
+ * Libera o vetor do heap
+ * @param heap Heap a ser destruído
+ */
+void heap_destroy(ProcessHeap* heap);
+
+/**
+ * Insere um processo - O(log n)
+ * @param heap Heap de destino
+ * @param pcb Processo a ser inserido
+ * @return 1 se sucesso, 0 se falha de alocação
+ */
+int heap_push(ProcessHeap* heap, PCB* pcb);
+
+/**
+ * Retorna o menor processo sem removê-lo - O(1)
+ * @param heap Heap consultado
+ * @return Menor processo ou NULL se vazio
+ */
+PCB* heap_peek(const ProcessHeap* heap);
+
+/**
+ * Remove e retorna o menor processo - O(log n)
+ * @param heap Heap consultado
+ * @return Menor processo ou NULL se vazio
+ */
+PCB* heap_pop(ProcessHeap* heap);
+
+/**
+ * Remove um processo qualquer pela posição guardada no PCB - O(log n)
+ * @param heap Heap que contém o processo
+ * @param pcb Processo a ser removido
+ * @return 1 se removeu, 0 se o processo não estava no heap
+ */
+int heap_remove(ProcessHeap* heap, PCB* pcb);
+
+/**
+ * Verifica se o heap está vazio
+ * @param heap Heap consultado
+ * @return true se vazio
+ */
+bool heap_is_empty(const ProcessHeap* heap);
+
+#endif // HEAP_H
@@ -0,0 +1,45 @@
+#ifndef HOTPLUG_H
+#define HOTPLUG_H
+
+#include "structures.h"
+#include <stdbool.h>
+
+/**
+ * Hotplug de CPUs durante a execução
+ * CPUs saem e entram de linha em instantes agendados (hotplug=MS:CPU:on|off)
+ * ou por comandos no arquivo hotplug_ctl ("off N" / "on N", um por linha).
+ * O processo de uma CPU que sai migra para uma CPU livre ou, sem nenhuma,
+ * devolve a CPU no fim do bloco (dreno); uma CPU que entra recebe o próximo
+ * processo da classe. A última CPU online não sai.
+ */
+
+// Evento aplicado e a recuperação medida depois dele
+typedef struct {
+    long at_ms;                 // Instante em que o evento foi aplicado
+    int cpu;                    // CPU do evento
+    bool online;                // true = CPU entrou, false = CPU saiu
+    int online_cpus;            // CPUs online depois do evento
+    int displaced_pid;          // Processo tirado da CPU que saiu (0 = nenhum)
+    bool drained;               // Processo sem CPU livre: devolveu a CPU no fim do bloco
+    long recovery_ms;           // Até a CPU nova executar ou o processo tirado voltar (-1 = ainda não)
+} HotplugEvent;
+
+/**
+ * Reinicia os eventos aplicados e a leitura do arquivo de comandos
+ */
+void hotplug_init(void);
+
+/**
+ * Aplica os eventos vencidos e os comandos novos e acompanha a recuperação
+ * Chamada a cada ciclo de despacho, depois do tick das classes
+ */
+void hotplug_apply(void);
+
+/**
+ * Obtém os eventos aplicados
+ * @param count Saída: número de eventos
+ * @return Eventos em ordem de aplicação
+ */
+const HotplugEvent* hotplug_get_events(int* count);
+
+#endif // HOTPLUG_H
@@ -0,0 +1,69 @@
+#ifndef IO_H
+#define IO_H
+
+#include "structures.h"
+#include <stdbool.h>
+
+// Estatísticas do dispositivo de E/S e da sobreposição com as CPUs
+typedef struct {
+    int ops;                    // Operações de E/S concluídas
+    long busy_ms;               // Tempo com uma E/S em serviço
+    long queue_ms;              // Espera total na fila do dispositivo
+    long overlap_ms;            // Tempo com E/S em serviço e alguma CPU ocupada
+    long cpu_busy_ms;           // CPUs x tempo ocupado
+    long elapsed_ms;            // Tempo observado pelo laço de despacho
+} IOStats;
+
+/**
+ * Inicializa o dispositivo de E/S simulado
+ * Um único dispositivo atende uma requisição por vez, em ordem de chegada
+ */
+void io_init(void);
+
+/**
+ * Libera a fila do dispositivo
+ */
+void io_destroy(void);
+
+/**
+ * Emite a próxima E/S do processo se o trabalho executado alcançou a rajada
+ * Chamada pelas threads com o mutex do processo travado, após descontar um bloco:
+ * pede a CPU de volta e o processo bloqueia no fim do bloco
+ * @param pcb Processo
+ */
+void io_check_burst(PCB* pcb);
+
+/**
+ * Coloca o processo bloqueado na fila do dispositivo
+ * @param pcb Processo em BLOCKED
+ * @param now_ms Tempo atual
+ */
+void io_submit(PCB* pcb, long now_ms);
+
+/**
+ * Retira o próximo processo cuja E/S terminou e inicia a seguinte da fila
+ * @param now_ms Tempo atual
+ * @return Processo a acordar (NULL = nenhum)
+ */
+PCB* io_next_completion(long now_ms);
+
+/**
+ * Verifica se há E/S em serviço ou na fila
+ * @return true se algum processo está bloqueado
+ */
+bool io_busy(void);
+
+/**
+ * Contabiliza o intervalo desde a última chamada (uma por ciclo de despacho)
+ * @param now_ms Tempo atual
+ * @param busy_cpus CPUs ocupadas no intervalo
+ */
+void io_account(long now_ms, int busy_cpus);
+
+/**
+ * Obtém as estatísticas do dispositivo
+ * @param out Estatísticas
+ */
+void io_get_stats(IOStats* out);
+
+#endif // IO_H
@@ -72,6 +72,20 @@ void log_process_preempted(const char* scheduler_name, int pid);
  */
 void log_quantum_expired(const char* scheduler_name, int pid);
 
+/**
+ * Adiciona mensagem de processo bloqueado em E/S
+ * @param scheduler_name Nome da política de escalonamento
+ * @param pid PID do processo
+ * @param io_ms Duração da E/S no dispositivo
+ */
+void log_process_blocked(const char* scheduler_name, int pid, int io_ms);
+
+/**
+ * Adiciona mensagem de E/S concluída (processo volta a pronto)
+ * @param pid PID do processo
+ */
+void log_process_io_done(int pid);
+
 /**
  * Adiciona mensagem de criação de processo
  * @param pid PID do processo criado
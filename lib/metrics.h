@@ -0,0 +1,35 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "structures.h"
+
+/**
+ * Registra o despacho de um processo para uma CPU
+ * Marca o primeiro despacho (tempo de resposta) e conta trocas de contexto
+ * @param pcb Processo despachado
+ */
+void metrics_on_dispatch(PCB* pcb);
+
+/**
+ * Registra que o processo entrou na fila de prontos (chegada ou devolução da CPU)
+ * O despacho seguinte fecha o intervalo de espera
+ * @param pcb Processo pronto
+ */
+void metrics_on_ready(PCB* pcb);
+
+/**
+ * Registra o término de um processo (idempotente)
+ * @param pcb Processo finalizado
+ */
+void metrics_on_finish(PCB* pcb);
+
+/**
+ * Grava o relatório de métricas da simulação em arquivo
+ * Inclui tempos de resposta/turnaround (média e cauda) e estatísticas
+ * de estrangulamento do controle de banda do CFS
+ * @param filename Nome do arquivo de saída (recomendado: "metricas_minikernel.txt")
+ * @return 1 se sucesso, 0 se erro
+ */
+int save_metrics_to_file(const char* filename);
+
+#endif // METRICS_H
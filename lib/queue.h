@@ -16,6 +16,13 @@ void init_ready_queue(ReadyQueue* queue);
  */
 void enqueue_process(ReadyQueue* queue, PCB* pcb);
 
+/**
+ * Adiciona um processo no início da fila (processo preemptado mantém a vez)
+ * @param queue Ponteiro para a fila
+ * @param pcb Ponteiro para o processo a ser adicionado
+ */
+void enqueue_process_front(ReadyQueue* queue, PCB* pcb);
+
 /**
  * Remove e retorna o próximo processo da fila (FCFS)
  * @param queue Ponteiro para a fila
@@ -38,6 +45,13 @@ int remove_process_from_queue(ReadyQueue* queue, PCB* pcb);
  */
 PCB* get_highest_priority_process(ReadyQueue* queue);
 
+/**
+ * Move todos os processos de src para o fim de dst, preservando a ordem - O(1)
+ * @param dst Fila de destino
+ * @param src Fila de origem (fica vazia)
+ */
+void splice_ready_queue(ReadyQueue* dst, ReadyQueue* src);
+
 /**
  * Verifica se a fila está vazia
  * @param queue Ponteiro para a fila
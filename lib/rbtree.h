@@ -1,46 +1,149 @@
 #ifndef RBTREE_H
 #define RBTREE_H
 
-#include "structures.h"
 #include <stdbool.h>
+#include <stddef.h>
 
-// Forward declaration
-struct PCB;
+// Constantes para Red-Black Tree
+#define RB_RED   0
+#define RB_BLACK 1
+
+/**
+ * Nó intrusivo da Red-Black Tree
+ * Embutido na estrutura que participa da árvore (ex.: PCB), permitindo
+ * que o mesmo objeto esteja em várias árvores ao mesmo tempo usando
+ * um RBNode para cada uma
+ */
+typedef struct RBNode {
+    struct RBNode* rb_left;     // Filho esquerdo
+    struct RBNode* rb_right;    // Filho direito
+    struct RBNode* rb_parent;   // Pai
+    int rb_color;               // Cor do nó (RB_RED ou RB_BLACK)
+    
+    // Aumento (estatística de ordem): mantido em inserções, remoções e rotações
+    long long rb_weight;        // Peso do nó (definido pelo dono antes de inserir)
+    int rb_size;                // Nós na subárvore (inclui o próprio)
+    long long rb_subtree_weight; // Soma dos pesos da subárvore
+} RBNode;
+
+/**
+ * Raiz da árvore com cache do nó mais à esquerda (menor chave em O(1))
+ */
+typedef struct {
+    RBNode* rb_node;            // Raiz
+    RBNode* rb_leftmost;        // Menor nó da árvore (NULL se vazia)
+} RBRoot;
+
+#define RB_ROOT_INIT { NULL, NULL }
+
+/**
+ * Obtém a estrutura que contém o nó
+ * @param ptr Ponteiro para o RBNode
+ * @param type Tipo da estrutura que embute o nó
+ * @param member Nome do campo RBNode dentro da estrutura
+ */
+#define rb_entry(ptr, type, member) \
+    ((type*)((char*)(ptr) - offsetof(type, member)))
 
 /**
  * Tipos de função para comparação e visita de nós
  */
-typedef int (*rb_compare_func_t)(struct PCB* a, struct PCB* b);
-typedef void (*rb_visit_func_t)(struct PCB* node);
+typedef int (*rb_compare_func_t)(const RBNode* a, const RBNode* b);
+typedef void (*rb_visit_func_t)(RBNode* node);
+typedef bool (*rb_key_less_func_t)(const RBNode* node, const void* key);
+
+/**
+ * Liga um nó recém-posicionado ao pai (sem balancear)
+ * @param node Nó a ser ligado
+ * @param parent Pai encontrado na descida
+ * @param link Ponteiro do pai (ou da raiz) que passará a apontar para o nó
+ */
+static inline void rb_link_node(RBNode* node, RBNode* parent, RBNode** link) {
+    node->rb_parent = parent;
+    node->rb_left = NULL;
+    node->rb_right = NULL;
+    node->rb_color = RB_RED;
+    node->rb_size = 1;
+    node->rb_subtree_weight = node->rb_weight;
+    *link = node;
+}
+
+/**
+ * Atualiza os agregados do caminho e rebalanceia a árvore após rb_link_node
+ * @param root Raiz da árvore
+ * @param node Nó recém-ligado
+ */
+void rb_insert_color(RBRoot* root, RBNode* node);
+
+/**
+ * Gera uma função de inserção com a comparação embutida (sem ponteiro de função)
+ * A função gerada tem a assinatura: void name(RBRoot* root, type* entry)
+ * @param name Nome da função gerada
+ * @param type Tipo da estrutura que embute o nó
+ * @param member Campo RBNode usado nesta árvore
+ * @param less Função ou macro less(type* a, type* b): true se a ordena antes de b
+ *             (empates vão para a direita, preservando ordem de chegada)
+ */
+#define RB_DEFINE_INSERT(name, type, member, less)                          \
+static inline void name(RBRoot* root, type* entry) {                        \
+    RBNode** link = &root->rb_node;                                         \
+    RBNode* parent = NULL;                                                  \
+    bool is_leftmost = true;                                                \
+    while (*link) {                                                         \
+        parent = *link;                                                     \
+        if (less(entry, rb_entry(parent, type, member))) {                  \
+            link = &parent->rb_left;                                        \
+        } else {                                                            \
+            link = &parent->rb_right;                                       \
+            is_leftmost = false;                                            \
+        }                                                                   \
+    }                                                                       \
+    rb_link_node(&entry->member, parent, link);                             \
+    if (is_leftmost) root->rb_leftmost = &entry->member;                    \
+    rb_insert_color(root, &entry->member);                                  \
+}
+
+/**
+ * Inicializa uma árvore vazia
+ * @param root Raiz da árvore
+ */
+void rb_init(RBRoot* root);
 
 /**
- * Insere nó na Red-Black Tree
- * @param root Ponteiro para raiz da árvore
+ * Insere nó na Red-Black Tree usando função de comparação
+ * @param root Raiz da árvore
  * @param new_node Nó a ser inserido
  * @param compare Função de comparação entre nós
  */
-void rb_insert(PCB** root, PCB* new_node, rb_compare_func_t compare);
+void rb_insert(RBRoot* root, RBNode* new_node, rb_compare_func_t compare);
 
 /**
  * Remove nó da Red-Black Tree
- * @param root Ponteiro para raiz da árvore
+ * @param root Raiz da árvore
  * @param node Nó a ser removido
  */
-void rb_remove(PCB** root, PCB* node);
+void rb_remove(RBRoot* root, RBNode* node);
 
 /**
- * Encontra nó mais à esquerda (menor valor)
+ * Encontra nó mais à esquerda (menor valor) - O(1) pelo cache
  * @param root Raiz da árvore
  * @return Nó com menor valor ou NULL se árvore vazia
  */
-PCB* rb_leftmost(PCB* root);
+RBNode* rb_leftmost(const RBRoot* root);
 
 /**
  * Encontra nó mais à direita (maior valor)
  * @param root Raiz da árvore
  * @return Nó com maior valor ou NULL se árvore vazia
  */
-PCB* rb_rightmost(PCB* root);
+RBNode* rb_rightmost(const RBRoot* root);
+
+/**
+ * Sucessor em ordem de um nó
+ * @param node Nó de referência
+ * @return Próximo nó em ordem crescente ou NULL
+ */
+RBNode* rb_next(const RBNode* node);
 
 /**
  * Busca nó específico na árvore
@@ -49,27 +152,70 @@ PCB* rb_rightmost(PCB* root);
  * @param compare Função de comparação
  * @return Nó encontrado ou NULL se não existe
  */
-PCB* rb_search(PCB* root, PCB* target, rb_compare_func_t compare);
+RBNode* rb_search(const RBRoot* root, const RBNode* target, rb_compare_func_t compare);
 
 /**
- * Conta número de nós na árvore
+ * Conta número de nós na árvore - O(1)
  * @param root Raiz da árvore
  * @return Número de nós
  */
-int rb_count_nodes(PCB* root);
+int rb_count_nodes(const RBRoot* root);
+
+/**
+ * Soma dos pesos de todos os nós - O(1)
+ * @param root Raiz da árvore
+ * @return Peso total
+ */
+long long rb_total_weight(const RBRoot* root);
+
+/**
+ * Posição do nó em ordem crescente (quantos nós vêm antes dele) - O(log n)
+ * @param node Nó presente na árvore
+ * @return Posição 0-based
+ */
+int rb_rank(const RBNode* node);
+
+/**
+ * Quantos nós são menores que uma chave e quanto peso eles somam - O(log n)
+ * @param root Raiz da árvore
+ * @param node_less Retorna true se o nó ordena antes da chave
+ * @param key Chave de referência
+ * @param weight_less Saída opcional: soma dos pesos dos nós menores
+ * @return Número de nós menores que a chave
+ */
+int rb_count_less(const RBRoot* root, rb_key_less_func_t node_less, const void* key,
+                  long long* weight_less);
+
+/**
+ * Seleciona o k-ésimo menor nó (percentis) - O(log n)
+ * @param root Raiz da árvore
+ * @param k Posição 0-based
+ * @return Nó na posição k ou NULL se fora do intervalo
+ */
+RBNode* rb_select(const RBRoot* root, int k);
+
+/**
+ * Seleciona o nó em que o peso acumulado em ordem ultrapassa target - O(log n)
+ * Com target = total/2 obtém a mediana ponderada; com target sorteado em
+ * [0, total) obtém seleção proporcional ao peso (loteria)
+ * @param root Raiz da árvore
+ * @param target Peso acumulado buscado, em [0, rb_total_weight)
+ * @return Nó encontrado ou NULL se target fora do intervalo
+ */
+RBNode* rb_select_by_weight(const RBRoot* root, long long target);
 
 /**
  * Percorre árvore em ordem crescente
  * @param root Raiz da árvore
  * @param visit Função chamada para cada nó visitado
  */
-void rb_inorder_walk(PCB* root, rb_visit_func_t visit);
+void rb_inorder_walk(const RBRoot* root, rb_visit_func_t visit);
 
 /**
  * Verifica se árvore está vazia
  * @param root Raiz da árvore
  * @return true se vazia, false caso contrário
  */
-bool rb_is_empty(PCB* root);
+bool rb_is_empty(const RBRoot* root);
 
 #endif // RBTREE_H
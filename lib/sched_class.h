@@ -0,0 +1,112 @@
+#ifndef SCHED_CLASS_H
+#define SCHED_CLASS_H
+
+#include "structures.h"
+#include <stdbool.h>
+
+/**
+ * Classe de escalonamento: operações que definem uma política
+ * O laço de despacho (scheduler.c) é único para MONO e MULTI e só conversa
+ * com a política por estas operações; uma nova política é uma nova instância
+ * de SchedClass registrada em sched_class_of()
+ */
+typedef struct SchedClass {
+    const char* name;                       // Rótulo usado no log ("FCFS", "RR", ...)
+
+    void (*init)(void);                     // Prepara a fila da política
+    void (*exit)(void);                     // Libera a fila da política
+
+    void (*enqueue)(PCB* process);          // Processo chegou e está pronto
+    void (*dequeue)(PCB* process);          // Retira processo da fila sem executá-lo
+    PCB* (*pick_next)(void);                // Remove e retorna o próximo a executar (NULL = nenhum)
+    void (*put_prev)(PCB* process);         // Processo deixou a CPU sem terminar
+
+    /**
+     * Contabiliza a execução de um processo em uma CPU
+     * @return true se a fatia acabou e o processo deve devolver a CPU
+     *         na fronteira do bloco em andamento
+     */
+    bool (*tick)(PCB* curr, long now_ms);
+
+    /**
+     * Avalia, após chegadas, se o processo em execução deve ceder a CPU
+     * @return true para preemptar curr
+     */
+    bool (*check_preempt)(PCB* curr);
+
+    bool (*has_queued)(void);               // Há processos aguardando nesta política
+
+    bool (*admit)(void);                    // Controle de admissão antes da simulação (NULL = aceita tudo)
+
+    void (*log_dispatch)(PCB* process, int cpu); // Log de despacho (NULL = formato padrão)
+    void (*log_finish)(PCB* process);            // Log de término (NULL = formato padrão)
+
+    bool preempt_now;                       // check_preempt interrompe o bloco em andamento
+    bool share_idle_cpus;                   // Rodízio entre CPUs: ocupa CPUs ociosas e
+                                            // redistribui os processos a cada término
+    bool gang;                              // Despacha todas as threads do processo juntas,
+                                            // uma CPU distinta por thread
+} SchedClass;
+
+extern const SchedClass fcfs_sched_class;
+extern const SchedClass rr_sched_class;
+extern const SchedClass priority_sched_class;
+extern const SchedClass cfs_sched_class;
+extern const SchedClass mlfq_sched_class;   // mlfq.c
+extern const SchedClass edf_sched_class;    // edf.c
+extern const SchedClass sjf_sched_class;    // sjf.c
+extern const SchedClass srtf_sched_class;   // sjf.c
+extern const SchedClass stride_sched_class; // share.c
+extern const SchedClass lottery_sched_class; // share.c
+extern const SchedClass rt_sched_class;     // rt.c
+extern const SchedClass slo_sched_class;    // slo.c
+extern SchedClass adaptive_sched_class;     // adaptive.c (share_idle_cpus segue a política ativa)
+extern const SchedClass gang_sched_class;   // gang.c
+extern const SchedClass backfill_sched_class; // backfill.c
+
+/**
+ * Estatísticas do estrangulamento do tempo real (política RT)
+ * @param nr_throttled Saída: vezes em que a banda de tempo real acabou
+ * @param throttled_ms Saída: tempo total com o tempo real estrangulado
+ */
+void rt_get_throttle_stats(int* nr_throttled, long* throttled_ms);
+
+/**
+ * Estatísticas da política ADAPTIVE
+ * @param time_ms Saída: tempo em cada política delegada (3 posições)
+ * @param names Saída: nome de cada política delegada (3 posições)
+ * @return Número de trocas de política
+ */
+int adaptive_get_stats(long time_ms[], const char* names[]);
+
+// Custo do gang scheduling (capacidade = ocupado + fragmentação + sincronização)
+typedef struct {
+    int slots;                  // Fatias executadas (linhas despachadas)
+    int max_rows;               // Maior número de linhas da matriz
+    long capacity_ms;           // CPUs x duração das fatias
+    long busy_ms;               // CPU ocupada por processos da fatia
+    long fragmented_ms;         // Colunas sem processo na linha da fatia
+} GangStats;
+
+/**
+ * Estatísticas da política GANG
+ * @param stats Saída: capacidade, uso e ociosidade das fatias
+ */
+void gang_get_stats(GangStats* stats);
+
+/**
+ * Estatísticas da política BACKFILL
+ * @param backfilled Saída: jobs que passaram à frente do primeiro da fila
+ * @param cpu_busy_ms Saída: CPUs x tempo ocupado pelos jobs
+ * @param span_ms Saída: do primeiro despacho ao último término
+ */
+void backfill_get_stats(int* backfilled, long* cpu_busy_ms, long* span_ms);
+
+/**
+ * Obtém a classe de escalonamento de uma política
+ * @param type Política escolhida na entrada
+ * @return Classe correspondente ou NULL se desconhecida
+ */
+const SchedClass* sched_class_of(SchedulerType type);
+
+#endif // SCHED_CLASS_H
@@ -2,6 +2,7 @@
 #define SCHEDULER_H
 
 #include "structures.h"
+#include <stdbool.h>
 
 /**
  * Inicializa o sistema de escalonamento
@@ -11,27 +12,14 @@
 void init_scheduler(SchedulerType scheduler_type, int quantum);
 
 /**
- * Thread principal do escalonador
+ * Thread principal do escalonador (monoprocessador)
+ * Executa o laço de despacho único sobre 1 CPU; a política vem da
+ * classe de escalonamento (sched_class.h)
  * @param arg Argumentos da thread (não utilizado)
  * @return NULL
  */
 void* scheduler_thread(void* arg);
 
-/**
- * Escalonamento FCFS (First Come First Served)
- */
-void schedule_fcfs();
-
-/**
- * Escalonamento Round Robin
- */
-void schedule_round_robin();
-
-/**
- * Escalonamento por Prioridade Preemptiva
- */
-void schedule_priority();
-
 /**
  * Coloca um processo em execução
  * @param pcb Ponteiro para o processo
@@ -39,28 +27,30 @@ void schedule_priority();
 void set_process_running(PCB* pcb);
 
 /**
- * Para a execução de um processo (preempção ou finalização)
- * @param pcb Ponteiro para o processo
+ * Configura processo para estado RUNNING
+ * @param pcb PCB do processo
  */
-void schedule_priority();
+void configure_process_state(PCB* pcb);
 
 /**
- * Implementação do algoritmo CFS (Completely Fair Scheduler)
- * Utiliza Red-Black Tree para escalonamento justo baseado em vruntime
+ * Para a execução de um processo (preempção ou finalização)
+ * @param pcb Ponteiro para o processo
  */
-void schedule_cfs();
+void stop_process_execution(PCB* pcb);
 
 /**
- * Configura processo para estado RUNNING
- * @param pcb PCB do processo
+ * Solicita que um processo em execução devolva a CPU
+ * As threads do processo passam para READY ao concluir o bloco atual
+ * @param pcb Ponteiro para o processo
  */
-void configure_process_state(PCB* pcb);
+void request_process_preemption(PCB* pcb);
 
 /**
- * Para a execução de um processo (preempção ou finalização)
+ * Retira a CPU de um processo imediatamente (estado READY)
+ * O bloco em andamento das threads é descartado
  * @param pcb Ponteiro para o processo
  */
-void stop_process_execution(PCB* pcb);
+void halt_process_execution(PCB* pcb);
 
 /**
  * Verifica se há processos de maior prioridade na fila
@@ -83,22 +73,137 @@ void sleep_ms(int milliseconds);
 void* scheduler_thread_cpu(void* arg);
 
 /**
- * Gerencia a execução multiprocessador
- * @param policy_names Array com nomes das políticas
- * @param log_msg Buffer para mensagens de log
+ * Obtém o tempo atual em milissegundos desde o início da simulação
+ * @return Tempo em milissegundos
  */
+long calculate_elapsed_time();
+
 /**
- * Executa escalonamento para sistemas multiprocessadores
- * @param scheduler_names Array com nomes das políticas de escalonamento
- * @param message_buffer Buffer para mensagens de log
+ * Cobra a sobrecarga de um despacho: cs_cost e a recarga do cache, que é
+ * o custo do nível da migração (domain_cost ou migration_cost) em outra CPU
+ * ou a parte já fria na mesma CPU (cache_decay)
+ * A dívida é descontada do trabalho dos próximos blocos do processo
+ * Chamada com o mutex do processo travado
+ * @param pcb Processo despachado
+ * @param last_cpu CPU do despacho anterior (-1 = primeiro despacho)
+ * @param cpu CPU do despacho
  */
-void execute_multicore_scheduling(const char* scheduler_names[], char* message_buffer);
+void charge_switch_overhead(PCB* pcb, int last_cpu, int cpu);
 
 /**
- * Obtém o tempo atual em milissegundos desde o início da simulação
- * @return Tempo em milissegundos
+ * Coloca um processo em uma CPU (NULL libera a CPU)
+ * Única escrita em current_process_array: mantém os mapas de CPUs ocupadas e
+ * livres e o cpu_mask dos processos
+ * @param cpu CPU
+ * @param pcb Processo ou NULL
  */
-long calculate_elapsed_time();
+void set_cpu_process(int cpu, PCB* pcb);
+
+/**
+ * Põe a CPU em linha ou a tira (hotplug); uma CPU fora de linha não fica livre
+ * @param cpu CPU
+ * @param online true para aceitar processos
+ */
+void set_cpu_online(int cpu, bool online);
+
+/**
+ * Verifica se a CPU aceita processos (hotplug)
+ * @param cpu CPU
+ * @return true se a CPU está online
+ */
+bool cpu_is_online(int cpu);
+
+/**
+ * Verifica se a CPU pode receber um processo agora
+ * @param cpu CPU
+ * @return true se a CPU está online e sem processo
+ */
+bool cpu_is_idle(int cpu);
+
+/**
+ * Primeira CPU livre a partir de uma CPU (find-first-set no mapa de livres)
+ * @param from Menor CPU aceita
+ * @return CPU livre ou -1 se nenhuma
+ */
+int next_idle_cpu(int from);
+
+/**
+ * Próxima CPU que é a primeira de um processo em execução
+ * Percorre cada processo em execução uma única vez, na CPU de menor índice
+ * @param from Primeira CPU a considerar
+ * @return CPU encontrada ou -1
+ */
+int next_running_process_cpu(int from);
+
+/**
+ * Conta as CPUs livres (popcount)
+ * @return CPUs online e sem processo
+ */
+int idle_cpu_count(void);
+
+/**
+ * Conta as CPUs ocupadas, inclusive as fora de linha ainda em dreno (popcount)
+ * @return CPUs com processo
+ */
+int busy_cpu_count(void);
+
+/**
+ * Conta as CPUs online (hotplug)
+ * @return CPUs que aceitam processos
+ */
+int online_cpus(void);
+
+/**
+ * CPUs em que o processo está (leitura atômica do cpu_mask)
+ * @param pcb Processo
+ * @return Máscara com um bit por CPU ocupada
+ */
+CpuMask cpu_mask_of_process(const PCB* pcb);
+
+/**
+ * Conta as CPUs em que o processo está (popcount do cpu_mask)
+ * @param pcb Processo
+ * @return CPUs ocupadas pelo processo
+ */
+int cpus_of_process(const PCB* pcb);
+
+/**
+ * Migra um processo em execução de uma CPU para outra livre
+ * O processo continua RUNNING (e a thread, no mesmo bloco); a CPU de destino
+ * é cobrada como um novo despacho em outra CPU
+ * @param pcb Processo em execução em from_cpu
+ * @param from_cpu CPU de origem
+ * @param to_cpu CPU livre de destino
+ */
+void migrate_running_process(PCB* pcb, int from_cpu, int to_cpu);
+
+/**
+ * Speedup de Amdahl: 1 / (s + (1 - s) / p), com p = min(cpus, threads)
+ * @param pcb Processo (define threads e fração serial s)
+ * @param cpus CPUs ocupadas pelo processo
+ * @return Speedup em relação a uma CPU
+ */
+double process_speedup(const PCB* pcb, int cpus);
+
+/**
+ * Trabalho que uma thread desconta de remaining_time ao concluir um bloco
+ * Sem amdahl=1 cada thread conta o bloco inteiro; com ele o bloco do processo
+ * rende THREAD_EXECUTION_TIME x speedup, repartido entre as threads
+ * @param pcb Processo
+ * @param cpus CPUs ocupadas pelo processo durante o bloco
+ * @return Trabalho em ms
+ */
+int thread_block_work_ms(const PCB* pcb, int cpus);
+
+/**
+ * Tempo de parede para executar parte do trabalho de um processo
+ * As threads executam blocos de THREAD_EXECUTION_TIME em paralelo, com o
+ * processo ocupando min(threads, CPUs) CPUs
+ * @param pcb Processo (define o número de threads)
+ * @param work_ms Trabalho a executar (ex.: remaining_time)
+ * @return Tempo de parede em ms (múltiplo do bloco)
+ */
+long process_service_time_ms(const PCB* pcb, int work_ms);
 
 /**
  * Verifica se todos os processos terminaram
@@ -144,11 +249,6 @@ void stop_process_execution_cpu2(PCB* pcb);
  * Implementação do Desafio Tópico 8 com Red-Black Tree
  */
 
-/**
- * Implementação do algoritmo CFS
- */
-void schedule_cfs();
-
 /**
  * Funções da Red-Black Tree para CFS
  */
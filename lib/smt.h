@@ -0,0 +1,96 @@
+#ifndef SMT_H
+#define SMT_H
+
+#include "structures.h"
+#include <stdbool.h>
+
+/**
+ * Contenção entre threads SMT irmãs e core scheduling
+ * Com smt=1 as CPUs formam núcleos (threads SMT da topologia, ou pares sem
+ * topology=); uma CPU cujo núcleo tem outra CPU ocupada rende smt_share% de
+ * um bloco. Com core_sched=1, CPUs irmãs só executam ao mesmo tempo processos
+ * do mesmo grupo de confiança (trust=G): a CPU fica ociosa em vez de juntar
+ * grupos diferentes no mesmo núcleo, e o processo recusado espera fora da
+ * classe até uma CPU compatível ficar livre.
+ */
+
+// Ocupação dos núcleos e custo do core scheduling
+typedef struct {
+    long core_ms;               // Núcleos x tempo observado
+    long shared_ms;             // Núcleos x tempo com mais de uma CPU ocupada
+    long forced_idle_ms;        // CPUs x tempo ociosas com processos esperando e irmã ocupada
+    int refusals;               // Processos recusados em uma CPU pelo core scheduling
+} SMTStats;
+
+/**
+ * Reinicia as estatísticas e a espera do core scheduling (uma execução)
+ */
+void smt_init(void);
+
+/**
+ * Libera a espera do core scheduling
+ */
+void smt_exit(void);
+
+/**
+ * CPUs por núcleo em vigor
+ * @return 1 sem SMT
+ */
+int smt_width(void);
+
+/**
+ * Verifica se o processo pode ocupar a CPU sem juntar grupos de confiança
+ * diferentes no mesmo núcleo (sempre true sem core_sched)
+ * @param pcb Processo
+ * @param cpu CPU livre
+ * @return true se as irmãs estão livres ou executam processos compatíveis
+ */
+bool core_sched_allows(const PCB* pcb, int cpu);
+
+/**
+ * CPU livre que o core scheduling permite, preferindo a indicada
+ * @param pcb Processo
+ * @param cpu CPU escolhida pelo despacho
+ * @return cpu, outra CPU livre permitida ou -1 se nenhuma
+ */
+int core_sched_select_cpu(PCB* pcb, int cpu);
+
+/**
+ * Guarda o processo recusado pelo core scheduling até uma CPU compatível
+ * @param pcb Processo escolhido pela classe sem CPU permitida
+ */
+void core_sched_hold(PCB* pcb);
+
+/**
+ * Retira o primeiro processo recusado que pode ocupar a CPU
+ * @param cpu CPU livre
+ * @return Processo a despachar (NULL = nenhum)
+ */
+PCB* core_sched_take_waiting(int cpu);
+
+/**
+ * Verifica se há processos recusados esperando
+ * @return true se algum processo está fora da classe esperando
+ */
+bool core_sched_has_waiting(void);
+
+/**
+ * Publica em cada processo em execução o rendimento das suas CPUs
+ * (média de 100% ou smt_share% conforme a irmã está ocupada)
+ */
+void smt_publish_speed(void);
+
+/**
+ * Contabiliza o intervalo desde a última chamada (uma por ciclo de despacho)
+ * @param now_ms Tempo atual
+ * @param queued Há processos esperando por CPU
+ */
+void smt_account(long now_ms, bool queued);
+
+/**
+ * Obtém as estatísticas de SMT
+ * @param out Estatísticas
+ */
+void smt_get_stats(SMTStats* out);
+
+#endif // SMT_H
@@ -2,12 +2,14 @@
 #define STRUCTURES_H
 
 #include <pthread.h>
+#include "rbtree.h"
 
 // Estados dos processos - conforme especificação 2.8
 typedef enum {
     READY,                      // Processo pronto para execução
     RUNNING,                    // Processo em execução
-    FINISHED                    // Processo finalizado
+    FINISHED,                   // Processo finalizado
+    BLOCKED                     // Aguardando E/S no dispositivo (rajadas io=CPU:IO)
 } ProcessState;
 
 // Políticas de escalonamento - conforme especificação seção 4.1
@@ -15,12 +17,64 @@ typedef enum {
     FCFS = 1,                   // First Come First Served
     ROUND_ROBIN = 2,            // Round Robin com quantum fixo
     PRIORITY = 3,               // Prioridade Preemptiva
-    CFS = 4                     // Completely Fair Scheduler (Desafio Tópico 8)
+    CFS = 4,                    // Completely Fair Scheduler (Desafio Tópico 8)
+    MLFQ = 5,                   // Multi-Level Feedback Queue
+    EDF = 6,                    // Earliest Deadline First
+    SJF = 7,                    // Shortest Job First (não preemptivo)
+    SRTF = 8,                   // Shortest Remaining Time First
+    STRIDE = 9,                 // Stride scheduling (fatia proporcional determinística)
+    LOTTERY = 10,               // Lottery scheduling (fatia proporcional por sorteio)
+    RT = 11,                    // Classes de tempo real (FIFO/RR) sobre o CFS
+    SLO = 12,                   // Menor folga até o SLO de latência, CFS sem pressão
+    ADAPTIVE = 13,              // Alterna entre FCFS, RR e CFS conforme a carga
+    GANG = 14,                  // Gang scheduling: threads do processo juntas (matriz de Ousterhout)
+    BACKFILL = 15               // FCFS de jobs rígidos (k CPUs) com EASY backfilling
 } SchedulerType;
 
-// Constantes para Red-Black Tree (CFS)
-#define RB_RED   0
-#define RB_BLACK 1
+// Classe de um processo na política RT (nomes evitam colisão com SCHED_* de <sched.h>)
+typedef enum {
+    RT_POLICY_NORMAL = 0,       // Melhor esforço: CFS
+    RT_POLICY_FIFO,             // Tempo real sem quantum
+    RT_POLICY_RR                // Tempo real com rodízio na mesma prioridade
+} RTPolicy;
+
+// Níveis da topologia, do mais próximo ao mais distante (domínios de escalonamento)
+typedef enum {
+    TOPO_CPU = 0,               // Mesma CPU
+    TOPO_SMT,                   // Threads irmãs do mesmo núcleo
+    TOPO_LLC,                   // Núcleos que compartilham o último nível de cache
+    TOPO_NODE,                  // Grupos de LLC do mesmo nó NUMA
+    TOPO_NUMA,                  // Nós diferentes
+    TOPO_LEVELS
+} TopoLevel;
+
+// Limite de grupos de banda do CFS (ids 1..MAX_CGROUPS)
+#define MAX_CGROUPS 16
+
+// Níveis de prioridade da entrada (1 = maior, PRIORITY_LEVELS = menor)
+#define PRIORITY_LEVELS 5
+
+// Prioridades de tempo real válidas: 1..RT_MAX_PRIO-1 (maior = mais urgente)
+#define RT_MAX_PRIO 100
+
+// Número máximo de níveis da MLFQ
+#define MLFQ_MAX_LEVELS 8
+
+// Rajadas de E/S declaráveis por processo (io=CPU:IO,...)
+#define MAX_IO_BURSTS 16
+
+// Eventos de hotplug agendáveis (hotplug=MS:CPU:on|off,...)
+#define MAX_HOTPLUG_EVENTS 32
+
+// Número máximo de CPUs simuladas (MONO usa 1, MULTI usa cpus=N, padrão 2)
+#define MAX_CPUS 16
+
+// Conjunto de CPUs, um bit por CPU (ffs encontra uma CPU, popcount conta)
+typedef unsigned long long CpuMask;
+#if MAX_CPUS > 64
+#error "CpuMask comporta no maximo 64 CPUs"
+#endif
+#define CPU_BIT(cpu) (1ULL << (cpu))
 
 // Estrutura BCP - Bloco de Controle de Processo (conforme seção 2.8)
 typedef struct PCB {
@@ -35,15 +89,105 @@ typedef struct PCB {
     int remaining_time;         // Tempo restante de execução (decrementado pelas threads)
     ProcessState state;         // Estado atual: READY, RUNNING ou FINISHED
     volatile int should_preempt; // Flag para indicar preempção
+    int preempt_epoch;          // Preempções imediatas; bloco iniciado antes da última é descartado
+    int dispatch_seq;           // Despachos do processo (cada thread executa ao menos um bloco por despacho)
+    int threads_in_block;       // Threads com bloco de execução em andamento
+    
+    // Progresso paralelo (modelo de Amdahl)
+    int serial_pct;             // Fração serial do trabalho em % (-1 = valor global)
+    int cpus_held;              // CPUs ocupadas, publicadas pelo escalonador a cada ciclo
+    CpuMask cpu_mask;           // CPUs em que o processo está (espelho de current_process_array)
+    
+    // Rajadas de E/S (opcionais): após executar io_at_ms[i] de trabalho, bloqueia io_ms[i]
+    int io_count;               // Rajadas de E/S declaradas
+    int io_at_ms[MAX_IO_BURSTS]; // Trabalho executado (acumulado) em que cada E/S é emitida
+    int io_ms[MAX_IO_BURSTS];   // Duração de cada E/S no dispositivo
+    int io_next;                // Próxima rajada a emitir
+    int io_pending;             // E/S emitida: o processo bloqueia no fim do bloco
+    int io_current_ms;          // Duração da E/S emitida
+    long io_blocked_ms;         // Tempo total bloqueado (fila do dispositivo e serviço)
+    long io_blocked_since_ms;   // Início do bloqueio atual (-1 = não bloqueado)
+    
+    // Custo de troca de contexto e de migração (cs_cost, migration_cost)
+    int last_cpu;               // CPU do último despacho (-1 = nunca executou)
+    int migrations;             // Despachos em CPU diferente da anterior
+    long off_cpu_ms;            // Última saída de CPU, início do resfriamento do cache (-1 = nunca)
+    long on_cpu_ms;             // Último despacho (tempo fora do nó de origem)
+    int home_node;              // Nó NUMA do primeiro despacho, onde está a memória (-1 = nenhum)
+    
+    // Núcleos SMT (smt=1) e core scheduling (core_sched=1)
+    int trust_group;            // Grupo de confiança: irmãs SMT só com o mesmo grupo (0 = sem trust=)
+    int smt_speed_pct;          // Rendimento das CPUs do processo, publicado pelo escalonador
+    int capacity_pct;           // Capacidade média das CPUs do processo (capacity=), publicada pelo escalonador
+    int overhead_debt_ms;       // Sobrecarga cobrada e ainda não descontada dos blocos
+    long overhead_ms;           // Sobrecarga paga em tempo de CPU
+    
+    // Despacho por thread (thread_sched=1)
+    struct TCB* tcbs;           // Threads do processo (vetor de num_threads)
+    int siblings_spread;        // Dica de afinidade: irmãs longe umas das outras (0 = próximas)
+    
+    // Prioridade com envelhecimento
+    int effective_priority;     // Prioridade efetiva no último despacho (<= priority)
+    
+    // Tempo real (política RT)
+    RTPolicy rt_policy;         // Classe do processo (normal = CFS)
+    int rt_priority;            // Prioridade de tempo real (1..99)
+    
+    // MLFQ
+    int mlfq_level;             // Nível atual (0 = maior prioridade)
+    int mlfq_boost_epoch;       // Último boost da MLFQ visto (-1 = nunca enfileirado)
+    
+    // EDF (deadline relativo opcional na entrada) e SLO de latência
+    int rel_deadline_ms;        // Deadline relativo à chegada (-1 = sem deadline)
+    int slo_ms;                 // Alvo de latência até o término (-1 = sem SLO)
+    int slo_boosted;            // Último despacho foi pela folga (não pelo CFS)
+    long abs_deadline_ms;       // Deadline absoluto (chegada + deadline ou SLO)
+    RBNode dl_node;             // Nó na árvore por deadline (EDF) ou por folga (SLO)
+    
+    // ADAPTIVE
+    int adaptive_epoch;         // Troca de política em que foi despachado pela última vez
+    
+    // GANG (posição na matriz de Ousterhout)
+    int gang_row;               // Linha (fatia de tempo) do processo (-1 = fora da matriz)
+    int gang_col;               // Primeira coluna ocupada na linha
+    long gang_dispatch_ms;      // Início do despacho atual (-1 = fora da CPU)
+    
+    // SJF/SRTF
+    int heap_index;             // Posição no heap de prontos (-1 = fora do heap)
+    
+    // STRIDE/LOTTERY (fatia proporcional aos bilhetes)
+    int tickets;                // Bilhetes explícitos (-1 = derivados da prioridade)
+    long long stride;           // STRIDE1 / bilhetes
+    long long pass;             // Passo acumulado; executa o menor
+    RBNode share_node;          // Nó na árvore por pass (STRIDE) ou por bilhetes (LOTTERY)
+    long share_dispatch_ms;     // Início do despacho atual
+    long share_received_ms;     // Tempo de CPU recebido enquanto ativo
+    double share_ideal_ms;      // Tempo de CPU devido pela fatia ideal
     
     // Campos específicos para CFS (Completely Fair Scheduler) - Desafio Tópico 8
     long long vruntime;         // Virtual runtime - tempo virtual acumulado (fairness)
     int weight;                 // Peso baseado na prioridade nice para cálculo de fairness
     long long start_vruntime;   // vruntime inicial para cálculo de diferenças
-    struct PCB* rb_left;        // Ponteiro para filho esquerdo na Red-Black Tree
-    struct PCB* rb_right;       // Ponteiro para filho direito na Red-Black Tree
-    struct PCB* rb_parent;      // Ponteiro para pai na Red-Black Tree
-    int rb_color;               // Cor do nó na RB Tree (0=preto, 1=vermelho)
+    RBNode run_node;            // Nó na árvore de vruntime do CFS (intrusivo)
+    int slice_us;               // Fatia calculada no último despacho pelo CFS
+    long slice_exec_ms;         // Runtime consumido desde o último despacho
+    
+    // Controle de banda do CFS (quota/período estilo cgroup)
+    int cgroup_id;              // Grupo de banda do processo (0 = sem grupo)
+    int cfs_quota_ms;           // Quota própria por período (-1 = usa o padrão global)
+    struct CFSBandwidth* cfs_b; // Pool de banda que limita o processo (NULL = ilimitado)
+    struct PCB* throttled_next; // Próximo na lista de processos estrangulados do pool
+    int runtime_snapshot;       // remaining_time na última contabilização (banda do CFS, quantum do RR)
+    
+    // Métricas de execução (tempos relativos ao início da simulação, em ms)
+    long first_run_ms;          // Primeiro despacho (-1 = ainda não executou)
+    long finish_ms;             // Término (-1 = ainda não terminou)
+    int throttle_count;         // Vezes em que o processo foi estrangulado
+    long throttled_ms;          // Tempo total fora da árvore por falta de quota
+    long throttle_start_ms;     // Início do estrangulamento atual (-1 = não estrangulado)
+    long ready_since_ms;        // Entrada na fila de prontos (-1 = não está esperando)
+    long max_wait_ms;           // Maior espera contínua na fila de prontos
+    long total_wait_ms;         // Espera total na fila de prontos
     
     // Mecanismos de sincronização
     pthread_mutex_t mutex;      // Mutex exclusivo para controlar acesso concorrente
@@ -52,9 +196,18 @@ typedef struct PCB {
 } PCB;
 
 // Estrutura TCB - Bloco de Controle de Thread (conforme seção 2.9)
-typedef struct {
+typedef struct TCB {
     PCB* pcb;                   // Ponteiro para o processo (BCP) ao qual a thread pertence
     int thread_index;           // Índice/posição da thread dentro do processo
+    
+    // Despacho por thread (thread_sched=1); protegidos pelo mutex do processo
+    int cpu;                    // CPU onde a thread executa (-1 = fora de CPU)
+    int last_cpu;               // CPU do último despacho (-1 = nunca executou)
+    int release;                // Devolução da CPU pedida para o fim do bloco
+    long run_ms;                // Tempo de CPU em blocos concluídos
+    int dispatches;             // Vezes que recebeu uma CPU
+    int migrations;             // Despachos em CPU diferente da anterior
+    int releases;               // CPUs devolvidas com o processo ainda em execução
 } TCB;
 
 // Estrutura da fila de prontos
@@ -71,26 +224,97 @@ typedef struct {
     pthread_cond_t cv;
 } ReadyQueue;
 
+// Pool de banda do CFS: quota de runtime recarregada a cada período
+typedef struct CFSBandwidth {
+    int id;                     // Grupo (1..MAX_CGROUPS) ou PID negado para pool próprio
+    int quota_ms;               // Runtime permitido por período
+    int period_ms;              // Duração do período de recarga
+    long runtime_remaining;     // Runtime restante no período (negativo = dívida)
+    long period_start_ms;       // Início do período atual
+    int throttled;              // 1 enquanto o pool está sem quota
+    long throttle_start_ms;     // Início do estrangulamento atual
+    int nr_throttled;           // Número de estrangulamentos do pool
+    long throttled_time_ms;     // Tempo total estrangulado
+    PCB* throttled_list;        // Processos retirados da árvore aguardando recarga
+} CFSBandwidth;
+
+// Parâmetros ajustáveis da simulação (chave=valor na entrada ou linha de comando)
+typedef struct {
+    int cfs_period_ms;          // Período de recarga da banda do CFS
+    int cfs_quota_ms;           // Quota padrão por processo (-1 = ilimitado)
+    int cgroup_quota_ms[MAX_CGROUPS + 1]; // Quota por grupo (-1 = ilimitado)
+    int sched_latency_us;       // Período alvo do CFS com poucos processos
+    int sched_min_granularity_us; // Fatia mínima; estica o período com muitos processos
+    int sched_wakeup_granularity_us; // Vantagem de vruntime exigida para preempção no wakeup
+    int mlfq_levels;            // Níveis da MLFQ (1..MLFQ_MAX_LEVELS)
+    int mlfq_quantum_ms[MLFQ_MAX_LEVELS]; // Quantum de cada nível
+    int mlfq_boost_ms;          // Intervalo do boost periódico para o nível 0 (0 = desligado)
+    int priority_aging_ms;      // Época do envelhecimento da PRIORITY (0 = desligado)
+    int slo_pressure_ms;        // Folga abaixo da qual o SLO passa à frente do CFS
+    int adaptive_window_ms;     // Janela de observação da ADAPTIVE
+    int adaptive_burst;         // Chegadas na janela que caracterizam rajada
+    int adaptive_scv_pct;       // C² dos tamanhos (em %) a partir do qual usa RR
+    int gang_slot_ms;           // Duração de cada fatia (linha da matriz) do GANG
+    int cpus;                   // CPUs simuladas no MULTI (2..MAX_CPUS)
+    int easy_backfill;          // Passo de backfill da BACKFILL (0 = FCFS rígido)
+    int bsld_tau_ms;            // Limite inferior da duração no slowdown limitado
+    int amdahl;                 // Progresso pela lei de Amdahl (0 = cada thread conta um bloco inteiro)
+    int serial_pct;             // Fração serial padrão dos processos, em %
+    int thread_sched;           // Despacho por thread: cada TCB ocupa uma CPU (0 = por processo)
+    int cs_cost_ms;             // Sobrecarga de CPU de cada troca de contexto
+    int migration_cost_ms;      // Recarga de cache de cada despacho em outra CPU
+    int rr_quantum_ms;          // Quantum do Round Robin
+    int affinity;               // Despacho prefere a CPU com o cache quente do processo
+    int cache_decay_ms;         // Tempo fora da CPU até o cache esfriar de vez (0 = não esfria)
+    int affinity_imbalance;     // CPUs livres toleradas enquanto um processo espera a CPU quente
+    int topo_nodes;             // Topologia (topology=N:L:C:T); 0 = CPUs planas, sem domínios
+    int topo_llcs;              // Grupos de LLC por nó
+    int topo_cores;             // Núcleos por grupo de LLC
+    int topo_smt;               // Threads (CPUs) por núcleo
+    int domain_cost_ms[TOPO_LEVELS]; // Recarga por migração em cada nível (-1 = migration_cost)
+    int balance_ms[TOPO_LEVELS];     // Intervalo mínimo entre migrações em cada nível
+    int smt;                    // CPUs agrupadas em núcleos SMT com contenção
+    int smt_share_pct;          // Rendimento de cada irmã com o núcleo compartilhado, em %
+    int core_sched;             // Irmãs SMT só com processos do mesmo grupo de confiança
+    int capacity_pct[MAX_CPUS]; // Capacidade de cada CPU em % (big.LITTLE; 100 = referência)
+    int capacity_aware;         // Pesados nas CPUs grandes, leves nas pequenas, migração de misfits
+    int misfit_ms;              // Trabalho restante a partir do qual o processo é pesado
+    int hotplug_count;          // Eventos de hotplug agendados (em ordem de instante)
+    long hotplug_at_ms[MAX_HOTPLUG_EVENTS]; // Instante de cada evento
+    int hotplug_cpu[MAX_HOTPLUG_EVENTS];    // CPU de cada evento
+    int hotplug_online[MAX_HOTPLUG_EVENTS]; // 1 = CPU entra, 0 = CPU sai
+    char hotplug_ctl[256];      // Arquivo de comandos de hotplug (vazio = nenhum)
+    int rt_period_ms;           // Período da banda de tempo real
+    int rt_runtime_ms;          // Tempo real permitido por CPU em cada período (-1 = ilimitado)
+    int rt_rr_quantum_ms;       // Quantum do SCHED_RR
+    unsigned int lottery_seed;  // Semente do gerador da LOTTERY (mesma semente = mesma execução)
+} SchedTunables;
+
 // Estrutura global do sistema
 typedef struct {
     PCB* pcb_list;              // Lista de todos os processos
     int process_count;          // Número total de processos
     ReadyQueue ready_queue;     // Fila de processos prontos
-    PCB* current_process;       // Processo atualmente em execução (CPU 0)
     SchedulerType scheduler_type; // Política de escalonamento
     int quantum;                // Quantum para Round Robin (ms)
     int generator_done;         // Flag para sinalizar fim da criação
     char* log_buffer;           // Buffer para logs
     int log_size;               // Tamanho atual do log
     long start_time_ms;         // Tempo de início da simulação
+    SchedTunables tunables;     // Parâmetros ajustáveis do escalonador
     
     // Mutexes e condições para sincronização do escalonador
     pthread_mutex_t scheduler_mutex; // Mutex para controle do escalonador
     pthread_cond_t scheduler_cv;     // Condição para sinalização do escalonador
     
+    PCB* current_process_array[MAX_CPUS]; // Processo em execução em cada CPU
+    struct TCB* current_thread_array[MAX_CPUS]; // Thread em cada CPU (apenas com tcb_sched)
+    int tcb_sched;                 // Despacho por thread em vigor (thread_sched=1 e classe sem gang)
+    int num_cpus;                  // Número de CPUs (1 mono, tunables.cpus no multiprocessador)
+    CpuMask online_cpus;           // CPUs que aceitam processos (hotplug)
+    CpuMask busy_cpus;             // CPUs com processo (inclusive fora de linha, até o dreno)
+    CpuMask idle_cpus;             // CPUs online e sem processo
 #ifdef MULTI
-    PCB* current_process_array[2]; // Array para processos nos 2 CPUs (compatível com fafa)
-    int num_cpus;                  // Número de CPUs (2 para multiprocessador)
     pthread_mutex_t cpu2_mutex;   // Mutex para controle da CPU 2
 #endif
 } SystemState;
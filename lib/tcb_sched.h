@@ -0,0 +1,65 @@
+#ifndef TCB_SCHED_H
+#define TCB_SCHED_H
+
+#include "structures.h"
+#include "sched_class.h"
+
+/**
+ * Despacho por thread (thread_sched=1)
+ * A classe continua ordenando processos; cada CPU recebe uma thread (TCB):
+ * o processo escolhido entra com uma thread e CPUs que sobram vão para as
+ * threads irmãs dos processos em execução. Com processos esperando, uma irmã
+ * devolve a CPU no fim do bloco. Classes gang já ocupam uma CPU por thread e
+ * mantêm o despacho por processo.
+ */
+
+/**
+ * Decide se o despacho por thread vale para a classe (system_state.tcb_sched)
+ * @param sched_class Classe em uso
+ */
+void tcb_sched_init(const SchedClass* sched_class);
+
+/**
+ * Coloca na CPU a thread do processo com menos tempo de CPU (antes do RUNNING)
+ * @param pcb Processo escolhido pela classe
+ * @param cpu CPU livre
+ */
+void tcb_bind_first(PCB* pcb, int cpu);
+
+/**
+ * Tira da CPU a thread que a ocupa (processo saiu da CPU ou terminou)
+ * @param cpu CPU a liberar
+ */
+void tcb_unbind_cpu(int cpu);
+
+/**
+ * Move a thread de uma CPU para outra livre (migração de processo em execução)
+ * Chamada com o mutex do processo travado
+ * @param from_cpu CPU de origem
+ * @param to_cpu CPU de destino
+ */
+void tcb_move_cpu(int from_cpu, int to_cpu);
+
+/**
+ * Libera as CPUs cujas threads já devolveram a CPU no fim do bloco
+ * O processo continua em execução nas demais CPUs
+ * @return CPUs liberadas
+ */
+int tcb_reap_released(void);
+
+/**
+ * Ocupa CPUs livres com threads irmãs dos processos em execução
+ * Só com a classe sem processos esperando; o processo com menos CPUs por
+ * thread recebe primeiro e a CPU segue a dica de afinidade (siblings)
+ * @param sched_class Classe em uso
+ */
+void tcb_fill_idle_cpus(const SchedClass* sched_class);
+
+/**
+ * Com processos esperando, pede que uma irmã do processo com mais CPUs
+ * devolva a sua no fim do bloco (uma devolução pendente por vez)
+ * @param sched_class Classe em uso
+ */
+void tcb_release_for_queue(const SchedClass* sched_class);
+
+#endif // TCB_SCHED_H
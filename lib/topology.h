@@ -0,0 +1,102 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include "structures.h"
+#include <stdbool.h>
+
+/**
+ * Topologia simulada (topology=N:L:C:T) e domínios de escalonamento
+ * CPUs numeradas em ordem: nó, grupo de LLC, núcleo e thread SMT
+ * (cpu = ((nó * L + llc) * C + núcleo) * T + thread). Cada nível tem custo
+ * de migração (domain_cost) e intervalo mínimo entre migrações (balance):
+ * dentro do LLC as migrações são livres e entre nós são raras.
+ * Sem topologia as CPUs são planas: todas compartilham um LLC.
+ */
+
+// Migrações e execução fora do nó de origem
+typedef struct {
+    int migrations[TOPO_LEVELS]; // Migrações por nível (TOPO_CPU não é usado)
+    int deferred;               // Migrações adiadas pelo intervalo do nível
+    long remote_ms;             // CPU x tempo em nó diferente do de origem
+    long run_ms;                // CPU x tempo total observado
+} TopoStats;
+
+/**
+ * CPUs descritas pela topologia
+ * @return Total de CPUs ou 0 sem topologia
+ */
+int topology_cpus(void);
+
+/**
+ * Reinicia as estatísticas e registra a topologia no log
+ */
+void topology_init(void);
+
+/**
+ * Nó NUMA de uma CPU (0 sem topologia)
+ * @param cpu CPU
+ * @return Nó da CPU
+ */
+int topo_node(int cpu);
+
+/**
+ * Menor domínio que contém as duas CPUs
+ * @param a Primeira CPU
+ * @param b Segunda CPU
+ * @return TOPO_CPU para a mesma CPU até TOPO_NUMA para nós diferentes
+ */
+TopoLevel topo_level(int a, int b);
+
+/**
+ * Recarga de cache de uma migração entre as CPUs (custo do nível)
+ * @param last_cpu CPU anterior
+ * @param cpu CPU nova
+ * @return Custo em ms (migration_cost se o nível não tem custo próprio)
+ */
+int topo_migration_cost(int last_cpu, int cpu);
+
+/**
+ * Verifica se o intervalo do nível da migração já passou
+ * @param last_cpu CPU anterior
+ * @param cpu CPU nova
+ * @param now_ms Tempo atual
+ * @return true se a migração pode acontecer agora
+ */
+bool topo_move_allowed(int last_cpu, int cpu, long now_ms);
+
+/**
+ * Registra uma migração (conta e reinicia o intervalo do nível)
+ * @param last_cpu CPU anterior
+ * @param cpu CPU nova
+ * @param now_ms Tempo atual
+ */
+void topo_note_migration(int last_cpu, int cpu, long now_ms);
+
+/**
+ * Conta uma migração adiada por estar dentro do intervalo do nível
+ */
+void topo_note_deferred(void);
+
+/**
+ * Registra o despacho do processo (o primeiro fixa o nó de origem)
+ * @param pcb Processo
+ * @param cpu CPU do despacho
+ * @param now_ms Tempo atual
+ */
+void topo_note_dispatch(PCB* pcb, int cpu, long now_ms);
+
+/**
+ * Contabiliza a execução do processo em uma CPU ao sair dela
+ * @param pcb Processo
+ * @param cpu CPU liberada
+ * @param now_ms Tempo atual
+ */
+void topo_note_leave(PCB* pcb, int cpu, long now_ms);
+
+/**
+ * Obtém as estatísticas da topologia
+ * @param out Estatísticas
+ */
+void topo_get_stats(TopoStats* out);
+
+#endif // TOPOLOGY_H
@@ -0,0 +1,350 @@
+#include "../lib/sched_class.h"
+#include "../lib/scheduler.h"
+#include "../lib/log.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * Meta-escalonador adaptativo (política ADAPTIVE)
+ * - Delega para FCFS, RR ou CFS e reavalia a escolha a cada janela de
+ *   adaptive_window ms: chegadas na janela, profundidade da fila e, entre os
+ *   processos ativos, variabilidade do trabalho restante (C² = variância /
+ *   média²) e mistura de prioridades; uma rajada fecha a janela na hora
+ * - Fila de até uma espera por CPU: FCFS (sem disputa, preempção só custa trocas)
+ * - Rajada de chegadas ou tamanhos muito variáveis: RR (curtos não esperam
+ *   atrás dos longos)
+ * - Fila longa com prioridades misturadas: CFS (fatia ponderada pela prioridade)
+ * - Fila longa de lote homogêneo: FCFS (rodízio só adiaria todos os términos)
+ * - Na troca os prontos migram da estrutura antiga para a nova; o PCB guarda o
+ *   trabalho restante e as métricas. Quem está executando termina o bloco e
+ *   volta pela nova política (exceto sob FCFS, que não preempta)
+ * - Cada troca e o tempo médio de resposta da janela seguinte vão para o log
+ */
+
+#define ADAPTIVE_POLICIES 3
+
+static const SchedClass* const adaptive_policies[ADAPTIVE_POLICIES] = {
+    &fcfs_sched_class, &rr_sched_class, &cfs_sched_class,
+};
+
+static const SchedClass* active;        // Política em uso
+static const SchedClass* draining;      // Política anterior com processos retidos (estrangulados pelo CFS)
+static int policy_epoch;                // Trocas feitas; processo despachado em outra época é estrangeiro
+
+// Janela de observação
+static long window_start_ms;
+static int window_arrivals;
+static long window_response_sum;        // Resposta dos primeiros despachos da janela
+static int window_responses;
+
+// Troca aguardando a janela seguinte para medir o efeito
+static bool effect_pending;
+static const SchedClass* effect_from;
+static double effect_before_ms;
+
+// Estatísticas para o arquivo de métricas
+static int switch_count;
+static long policy_time_ms[ADAPTIVE_POLICIES];
+static long policy_since_ms;
+
+// Sinais da carga no fim de uma janela
+typedef struct {
+    int arrivals;               // Chegadas na janela
+    int depth;                  // Processos esperando na fila de prontos
+    double scv;                 // C² do trabalho restante dos processos ativos
+    bool mixed_priority;        // Processos ativos com prioridades diferentes
+} AdaptiveLoad;
+
+static int policy_index(const SchedClass* policy) {
+    for (int index = 0; index < ADAPTIVE_POLICIES; index++) {
+        if (adaptive_policies[index] == policy) {
+            return index;
+        }
+    }
+    return 0;
+}
+
+/* Média de resposta dos primeiros despachos da janela (-1 = nenhum) */
+static double window_mean_response(void) {
+    return window_responses > 0 ? (double)window_response_sum / window_responses : -1.0;
+}
+
+static void format_response(char* text, size_t size, double mean_ms) {
+    if (mean_ms < 0) {
+        snprintf(text, size, "-");
+    } else {
+        snprintf(text, size, "%.0fms", mean_ms);
+    }
+}
+
+/* Mede os processos ativos: esperando na fila (ready_since >= 0) ou executando */
+static AdaptiveLoad adaptive_measure(void) {
+    AdaptiveLoad load = { .arrivals = window_arrivals };
+    double sum = 0.0;
+    double sq_sum = 0.0;
+    int active_count = 0;
+    int first_priority = 0;
+    
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        bool waiting = pcb->ready_since_ms >= 0;
+        if (!waiting && pcb->state != RUNNING) continue;
+        
+        if (waiting) load.depth++;
+        sum += pcb->remaining_time;
+        sq_sum += (double)pcb->remaining_time * pcb->remaining_time;
+        if (active_count == 0) {
+            first_priority = pcb->priority;
+        } else if (pcb->priority != first_priority) {
+            load.mixed_priority = true;
+        }
+        active_count++;
+    }
+    
+    if (active_count >= 2 && sum > 0) {
+        double mean = sum / active_count;
+        load.scv = (sq_sum / active_count - mean * mean) / (mean * mean);
+    }
+    return load;
+}
+
+/**
+ * Escolhe a política para a carga medida
+ * Histerese: já em RR, só sai com C² abaixo da metade do limiar
+ */
+static const SchedClass* adaptive_classify(const AdaptiveLoad* load) {
+    if (load->depth <= system_state.num_cpus) {
+        return &fcfs_sched_class;
+    }
+    double scv_pct = system_state.tunables.adaptive_scv_pct;
+    if (active == &rr_sched_class) {
+        scv_pct /= 2;
+    }
+    if (load->arrivals >= system_state.tunables.adaptive_burst || load->scv * 100.0 >= scv_pct) {
+        return &rr_sched_class;
+    }
+    return load->mixed_priority ? &cfs_sched_class : &fcfs_sched_class;
+}
+
+/**
+ * Move os prontos da política ativa para next sem perder nenhum
+ * Esvazia a estrutura antiga antes de preencher a nova: FCFS e RR usam a mesma fila
+ */
+static void adaptive_migrate(const SchedClass* next) {
+    PCB** ready = malloc(system_state.process_count * sizeof(PCB*));
+    if (ready == NULL) {
+        draining = active;
+        return;
+    }
+    int moved = 0;
+    PCB* process;
+    while (moved < system_state.process_count && (process = active->pick_next()) != NULL) {
+        ready[moved++] = process;
+    }
+    // O CFS só devolve os estrangulados na recarga: ficam até lá na estrutura antiga
+    draining = active->has_queued() ? active : NULL;
+    
+    for (int index = 0; index < moved; index++) {
+        next->enqueue(ready[index]);
+    }
+    free(ready);
+    add_log_message("[ADAPTIVE] %d processo(s) migrado(s) de %s para %s%s\n", moved, active->name, next->name,
+                    draining ? " (estrangulados aguardam a recarga)" : "");
+}
+
+static void adaptive_switch(const SchedClass* next, long now_ms, const AdaptiveLoad* load) {
+    char response[32];
+    double mean = window_mean_response();
+    format_response(response, sizeof(response), mean);
+    add_essential_log_message("[ADAPTIVE] %ldms: %s -> %s (chegadas %d, fila %d, C2 %.2f, prioridades %s, resposta media na janela %s)\n",
+                              now_ms, active->name, next->name, load->arrivals, load->depth, load->scv,
+                              load->mixed_priority ? "mistas" : "iguais", response);
+    
+    adaptive_migrate(next);
+    
+    policy_time_ms[policy_index(active)] += now_ms - policy_since_ms;
+    policy_since_ms = now_ms;
+    effect_pending = true;
+    effect_from = active;
+    effect_before_ms = mean;
+    
+    active = next;
+    policy_epoch++;
+    switch_count++;
+    // O laço de despacho lê as flags da classe a cada ciclo
+    adaptive_sched_class.share_idle_cpus = next->share_idle_cpus;
+}
+
+/**
+ * Fecha a janela se ela acabou (ou se force): registra o efeito da última troca
+ * e reavalia a política
+ */
+static void adaptive_evaluate(long now_ms, bool force) {
+    if (!force && now_ms - window_start_ms < system_state.tunables.adaptive_window_ms) {
+        return;
+    }
+    
+    if (effect_pending) {
+        char before[32];
+        char after[32];
+        format_response(before, sizeof(before), effect_before_ms);
+        format_response(after, sizeof(after), window_mean_response());
+        add_essential_log_message("[ADAPTIVE] Efeito %s -> %s: resposta media na janela %s -> %s\n",
+                                  effect_from->name, active->name, before, after);
+        effect_pending = false;
+    }
+    
+    AdaptiveLoad load = adaptive_measure();
+    const SchedClass* next = adaptive_classify(&load);
+    if (next != active) {
+        adaptive_switch(next, now_ms, &load);
+    }
+    
+    window_start_ms = now_ms;
+    window_arrivals = 0;
+    window_response_sum = 0;
+    window_responses = 0;
+}
+
+static bool is_foreign(const PCB* process) {
+    return process->adaptive_epoch != policy_epoch;
+}
+
+static void adaptive_init(void) {
+    // FCFS e RR compartilham a fila em lista: inicializa cada estrutura uma vez
+    fcfs_sched_class.init();
+    cfs_sched_class.init();
+    active = &cfs_sched_class;
+    draining = NULL;
+    policy_epoch = 0;
+    window_start_ms = calculate_elapsed_time();
+    window_arrivals = 0;
+    window_response_sum = 0;
+    window_responses = 0;
+    effect_pending = false;
+    switch_count = 0;
+    for (int index = 0; index < ADAPTIVE_POLICIES; index++) {
+        policy_time_ms[index] = 0;
+    }
+    policy_since_ms = window_start_ms;
+    adaptive_sched_class.share_idle_cpus = active->share_idle_cpus;
+}
+
+static void adaptive_exit(void) {
+    fcfs_sched_class.exit();
+    cfs_sched_class.exit();
+}
+
+static void adaptive_enqueue(PCB* process) {
+    window_arrivals++;
+    active->enqueue(process);
+    
+    // Rajada em andamento: não espera o fim da janela para trocar
+    if (window_arrivals >= system_state.tunables.adaptive_burst && active != &rr_sched_class) {
+        adaptive_evaluate(calculate_elapsed_time(), true);
+    }
+}
+
+/* Processo terminou em execução: sai de qualquer estrutura que o conheça */
+static void adaptive_dequeue(PCB* process) {
+    active->dequeue(process);
+    if (draining) {
+        draining->dequeue(process);
+    }
+}
+
+static PCB* adaptive_pick_next(void) {
+    long now = calculate_elapsed_time();
+    adaptive_evaluate(now, false);
+    
+    PCB* process = active->pick_next();
+    if (process != NULL) {
+        process->adaptive_epoch = policy_epoch;
+    } else if (draining) {
+        process = draining->pick_next();
+        if (process != NULL) {
+            process->adaptive_epoch = policy_epoch - 1;
+        } else if (!draining->has_queued()) {
+            draining = NULL;
+        }
+    }
+    if (process == NULL) {
+        return NULL;
+    }
+    
+    if (process->first_run_ms < 0) {
+        window_response_sum += now - process->start_time;
+        window_responses++;
+    }
+    return process;
+}
+
+/* Despachado pela política anterior: entra na atual como recém-chegado */
+static void adaptive_put_prev(PCB* process) {
+    if (is_foreign(process)) {
+        active->enqueue(process);
+    } else {
+        active->put_prev(process);
+    }
+}
+
+static bool adaptive_tick(PCB* curr, long now_ms) {
+    adaptive_evaluate(now_ms, false);
+    if (is_foreign(curr)) {
+        // Devolve a CPU no fim do bloco para a nova política decidir (FCFS não preempta)
+        return active != &fcfs_sched_class;
+    }
+    return active->tick(curr, now_ms);
+}
+
+static bool adaptive_check_preempt(PCB* curr) {
+    return !is_foreign(curr) && active->check_preempt(curr);
+}
+
+static bool adaptive_has_queued(void) {
+    return active->has_queued() || (draining && draining->has_queued());
+}
+
+static void adaptive_log_dispatch(PCB* process, int cpu) {
+    if (active->log_dispatch) {
+        active->log_dispatch(process, cpu);
+        return;
+    }
+#ifdef MULTI
+    log_process_start_cpu(active->name, process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start(active->name, process->pid);
+#endif
+}
+
+static void adaptive_log_finish(PCB* process) {
+    log_process_finish(active->name, process->pid);
+}
+
+int adaptive_get_stats(long time_ms[], const char* names[]) {
+    for (int index = 0; index < ADAPTIVE_POLICIES; index++) {
+        time_ms[index] = policy_time_ms[index];
+        names[index] = adaptive_policies[index]->name;
+    }
+    if (active != NULL) {
+        time_ms[policy_index(active)] += calculate_elapsed_time() - policy_since_ms;
+    }
+    return switch_count;
+}
+
+// Não const: share_idle_cpus segue a política ativa
+SchedClass adaptive_sched_class = {
+    .name = "ADAPTIVE",
+    .init = adaptive_init,
+    .exit = adaptive_exit,
+    .enqueue = adaptive_enqueue,
+    .dequeue = adaptive_dequeue,
+    .pick_next = adaptive_pick_next,
+    .put_prev = adaptive_put_prev,
+    .tick = adaptive_tick,
+    .check_preempt = adaptive_check_preempt,
+    .has_queued = adaptive_has_queued,
+    .log_dispatch = adaptive_log_dispatch,
+    .log_finish = adaptive_log_finish,
+};
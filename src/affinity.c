@@ -0,0 +1,160 @@
+#include "../lib/affinity.h"
+#include "../lib/scheduler.h"
+#include "../lib/log.h"
+#include "../lib/topology.h"
+
+/**
+ * Afinidade de cache
+ * - O calor do cache é 1 na CPU do último despacho ao sair dela e cai
+ *   linearmente até 0 em cache_decay ms (0 = não esfria); nas outras CPUs é 0
+ * - A penalidade de recarga (migration_cost) é proporcional à parte fria
+ * - Um processo cuja CPU quente está ocupada espera por ela em parked[cpu]
+ *   (no máximo um por CPU), fora da classe; desiste quando o cache cai
+ *   abaixo de 50% ou quando há mais CPUs livres que affinity_imbalance
+ * - Com topologia (topology=N:L:C:T), mesmo sem afinidade, a CPU livre
+ *   escolhida é a mais próxima da anterior (núcleo, LLC, nó) cuja migração
+ *   o intervalo do nível permite; sem nenhuma, o processo espera pela sua
+ * - Sem afinidade nem topologia o despacho percorre as CPUs em ordem de índice
+ * - CPU quente fora de linha (hotplug) não segura ninguém: o processo vai
+ *   para a CPU livre mais próxima, sem o intervalo do domínio
+ */
+
+static PCB* parked[MAX_CPUS];   // Processo esperando por cada CPU (NULL = nenhum)
+static long cpu_left_ms[MAX_CPUS]; // Última saída de um processo (-1 = nunca usada)
+static AffinityStats stats;
+
+/* Vale esperar pela CPU quente: cache ainda quente e CPUs livres dentro do limite */
+static bool worth_waiting(const PCB* pcb, long now_ms) {
+    return system_state.tunables.cache_decay_ms > 0 && cpu_is_online(pcb->last_cpu) &&
+           cache_warmth(pcb, pcb->last_cpu, pcb->last_cpu, now_ms) >= 0.5 &&
+           idle_cpu_count() <= system_state.tunables.affinity_imbalance;
+}
+
+/* Pode deixar a CPU quente e ir para cpu agora */
+static bool may_migrate(const PCB* pcb, int cpu, long now_ms) {
+    if (system_state.tunables.affinity && worth_waiting(pcb, now_ms)) {
+        return false;
+    }
+    return !cpu_is_online(pcb->last_cpu) || topo_move_allowed(pcb->last_cpu, cpu, now_ms);
+}
+
+/**
+ * CPU livre mais próxima da anterior pela topologia; no mesmo nível, a que
+ * esfriou há mais tempo (preserva caches quentes de outros)
+ * @param allowed_only Apenas migrações que o intervalo do nível permite
+ * @return CPU ou -1 se nenhuma serve
+ */
+static int nearest_free_cpu(const PCB* pcb, long now_ms, bool allowed_only) {
+    int best = -1;
+    TopoLevel best_level = TOPO_LEVELS;
+    for (int cpu = next_idle_cpu(0); cpu >= 0; cpu = next_idle_cpu(cpu + 1)) {
+        if (allowed_only && !topo_move_allowed(pcb->last_cpu, cpu, now_ms)) continue;
+        
+        TopoLevel level = topo_level(pcb->last_cpu, cpu);
+        if (level < best_level || (level == best_level && cpu_left_ms[cpu] < cpu_left_ms[best])) {
+            best = cpu;
+            best_level = level;
+        }
+    }
+    return best;
+}
+
+void affinity_init(void) {
+    for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
+        parked[cpu] = NULL;
+        cpu_left_ms[cpu] = -1;
+    }
+    stats = (AffinityStats){ 0 };
+}
+
+void affinity_note_leave(PCB* pcb, int cpu, long now_ms) {
+    pcb->off_cpu_ms = now_ms;
+    cpu_left_ms[cpu] = now_ms;
+}
+
+double cache_warmth(const PCB* pcb, int last_cpu, int cpu, long now_ms) {
+    if (last_cpu != cpu) {
+        return 0.0;
+    }
+    int decay = system_state.tunables.cache_decay_ms;
+    if (decay == 0 || pcb->off_cpu_ms < 0) {
+        return 1.0;
+    }
+    long away = now_ms - pcb->off_cpu_ms;
+    return away >= decay ? 0.0 : 1.0 - (double)away / decay;
+}
+
+void affinity_note_dispatch(bool migrated, int miss_ms) {
+    if (migrated) {
+        stats.migrations++;
+    } else {
+        stats.warm_dispatches++;
+    }
+    stats.miss_ms += miss_ms;
+}
+
+PCB* affinity_take_parked(int cpu) {
+    PCB* pcb = parked[cpu];
+    if (pcb != NULL) {
+        parked[cpu] = NULL;
+        return pcb;
+    }
+    
+    long now = calculate_elapsed_time();
+    for (int other = 0; other < system_state.num_cpus; other++) {
+        pcb = parked[other];
+        if (pcb != NULL && may_migrate(pcb, cpu, now)) {
+            parked[other] = NULL;
+            add_log_message("[AFINIDADE] PID %d desiste da CPU %d\n", pcb->pid, other);
+            return pcb;
+        }
+    }
+    return NULL;
+}
+
+int affinity_select_cpu(PCB* pcb, int free_cpu) {
+    if ((!system_state.tunables.affinity && topology_cpus() == 0) || pcb->last_cpu < 0) {
+        return free_cpu;
+    }
+    
+    int warm = pcb->last_cpu;
+    if (cpu_is_idle(warm)) {
+        return warm;
+    }
+    
+    long now = calculate_elapsed_time();
+    if (!cpu_is_online(warm)) {
+        return nearest_free_cpu(pcb, now, false); // CPU quente saiu de linha: não há por que esperar
+    }
+    bool hold = system_state.tunables.affinity && worth_waiting(pcb, now);
+    int nearest = nearest_free_cpu(pcb, now, true);
+    if ((hold || nearest < 0) && parked[warm] == NULL) {
+        parked[warm] = pcb;
+        if (hold) {
+            stats.holds++;
+            add_log_message("[AFINIDADE] PID %d espera a CPU %d (cache %.0f%% quente)\n",
+                            pcb->pid, warm, 100.0 * cache_warmth(pcb, warm, warm, now));
+        } else {
+            topo_note_deferred();
+            add_log_message("[AFINIDADE] PID %d espera a CPU %d (migracao adiada pelo intervalo do dominio)\n",
+                            pcb->pid, warm);
+        }
+        return -1;
+    }
+    
+    // Sem vaga para esperar: a mais próxima mesmo fora do intervalo
+    return nearest >= 0 ? nearest : nearest_free_cpu(pcb, now, false);
+}
+
+bool affinity_has_parked(void) {
+    for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+        if (parked[cpu] != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void affinity_get_stats(AffinityStats* out) {
+    *out = stats;
+}
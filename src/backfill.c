@@ -0,0 +1,201 @@
+#include "../lib/sched_class.h"
+#include "../lib/scheduler.h"
+#include "../lib/log.h"
+#include <stdlib.h>
+
+/**
+ * FCFS com EASY backfilling para jobs rígidos (política BACKFILL)
+ * - Cada job pede k = min(num_threads, num_cpus) CPUs de uma vez e só
+ *   começa com todas livres; executa até o fim sem preempção
+ * - O primeiro da fila recebe uma reserva: o instante (sombra) em que os jobs
+ *   em execução terão liberado CPUs suficientes, pelo trabalho restante deles
+ * - Um job de trás pode passar à frente (backfill) se cabe nas CPUs livres e
+ *   termina antes da sombra, ou se usa só as CPUs que sobram para a reserva
+ * - backfill=0 desliga o passo de backfill (FCFS rígido, base de comparação)
+ * - A estimativa de duração é exata (process_len), sem o erro de estimativa
+ *   dos usuários de um cluster real
+ */
+
+static PCB** waiting;           // Fila de espera em ordem de chegada
+static int nr_waiting;
+static int nr_backfilled;
+static long busy_ms;            // CPUs x tempo ocupado pelos jobs (início = first_run_ms)
+static long first_dispatch_ms;  // Primeiro despacho (-1 = nenhum)
+static long last_finish_ms;
+
+/* CPUs do job: limitadas às online, para que um job largo não espere CPUs fora de linha */
+static int job_width(const PCB* process) {
+    int online = online_cpus();
+    return process->num_threads < online ? process->num_threads : online;
+}
+
+/* Fim previsto de um job pelo trabalho restante */
+static long job_end_ms(const PCB* process, long now_ms) {
+    return now_ms + process_service_time_ms(process, process->remaining_time);
+}
+
+/**
+ * Calcula a reserva do primeiro da fila
+ * @param head Job reservado
+ * @param free CPUs livres agora
+ * @param extra Saída: CPUs livres na sombra que a reserva não usa
+ * @return Instante da sombra (quando head terá CPUs suficientes)
+ */
+static long easy_shadow(const PCB* head, int free, long now_ms, int* extra) {
+    // Jobs em execução (um por processo, não por CPU) ordenados pelo fim previsto
+    PCB* running[MAX_CPUS];
+    int nr_running = 0;
+    for (int processor = 0; processor < system_state.num_cpus; processor++) {
+        PCB* process = system_state.current_process_array[processor];
+        bool seen = false;
+        for (int index = 0; index < nr_running && process != NULL; index++) {
+            seen = seen || running[index] == process;
+        }
+        if (process != NULL && !seen) {
+            int pos = nr_running++;
+            while (pos > 0 && job_end_ms(running[pos - 1], now_ms) > job_end_ms(process, now_ms)) {
+                running[pos] = running[pos - 1];
+                pos--;
+            }
+            running[pos] = process;
+        }
+    }
+    
+    int available = free;
+    for (int index = 0; index < nr_running; index++) {
+        available += job_width(running[index]);
+        if (available >= job_width(head)) {
+            *extra = available - job_width(head);
+            return job_end_ms(running[index], now_ms);
+        }
+    }
+    *extra = 0;
+    return now_ms;
+}
+
+static void remove_waiting(int index) {
+    for (int next = index + 1; next < nr_waiting; next++) {
+        waiting[next - 1] = waiting[next];
+    }
+    nr_waiting--;
+}
+
+static PCB* dispatch_waiting(int index, long now_ms) {
+    PCB* process = waiting[index];
+    remove_waiting(index);
+    if (first_dispatch_ms < 0) {
+        first_dispatch_ms = now_ms;
+    }
+    return process;
+}
+
+static void backfill_init(void) {
+    int capacity = system_state.process_count > 0 ? system_state.process_count : 1;
+    waiting = malloc(capacity * sizeof(PCB*));
+    nr_waiting = 0;
+    nr_backfilled = 0;
+    busy_ms = 0;
+    first_dispatch_ms = -1;
+    last_finish_ms = 0;
+}
+
+static void backfill_exit(void) {
+    free(waiting);
+    waiting = NULL;
+}
+
+static void backfill_enqueue(PCB* process) {
+    if (waiting != NULL) {
+        waiting[nr_waiting++] = process;
+    }
+}
+
+/* Job terminou: contabiliza as CPUs que ocupou */
+static void backfill_dequeue(PCB* process) {
+    for (int index = 0; index < nr_waiting; index++) {
+        if (waiting[index] == process) {
+            remove_waiting(index);
+            return;
+        }
+    }
+    long now = calculate_elapsed_time();
+    busy_ms += (now - process->first_run_ms) * job_width(process);
+    last_finish_ms = now;
+}
+
+static PCB* backfill_pick_next(void) {
+    if (nr_waiting == 0) {
+        return NULL;
+    }
+    long now = calculate_elapsed_time();
+    int free = idle_cpu_count();
+    PCB* head = waiting[0];
+    if (job_width(head) <= free) {
+        return dispatch_waiting(0, now);
+    }
+    if (!system_state.tunables.easy_backfill) {
+        return NULL;
+    }
+    
+    int extra;
+    long shadow = easy_shadow(head, free, now, &extra);
+    for (int index = 1; index < nr_waiting; index++) {
+        PCB* candidate = waiting[index];
+        int width = job_width(candidate);
+        if (width > free) continue;
+        
+        bool ends_before_shadow = job_end_ms(candidate, now) <= shadow;
+        if (ends_before_shadow || width <= extra) {
+            add_log_message("[BACKFILL] PID %d passa a frente do PID %d (%d CPU(s), %s; reserva em %ldms)\n",
+                            candidate->pid, head->pid, width,
+                            ends_before_shadow ? "termina antes da reserva" : "usa CPUs que sobram", shadow);
+            nr_backfilled++;
+            return dispatch_waiting(index, now);
+        }
+    }
+    return NULL;
+}
+
+/* Sem preempção: só volta à fila se o laço não conseguiu alocá-lo */
+static void backfill_put_prev(PCB* process) {
+    for (int index = nr_waiting; index > 0; index--) {
+        waiting[index] = waiting[index - 1];
+    }
+    waiting[0] = process;
+    nr_waiting++;
+}
+
+static bool backfill_tick(PCB* curr, long now_ms) {
+    (void)curr;
+    (void)now_ms;
+    return false;
+}
+
+static bool backfill_check_preempt(PCB* curr) {
+    (void)curr;
+    return false;
+}
+
+static bool backfill_has_queued(void) {
+    return nr_waiting > 0;
+}
+
+void backfill_get_stats(int* backfilled, long* cpu_busy_ms, long* span_ms) {
+    *backfilled = nr_backfilled;
+    *cpu_busy_ms = busy_ms;
+    *span_ms = first_dispatch_ms >= 0 ? last_finish_ms - first_dispatch_ms : 0;
+}
+
+const SchedClass backfill_sched_class = {
+    .name = "BACKFILL",
+    .init = backfill_init,
+    .exit = backfill_exit,
+    .enqueue = backfill_enqueue,
+    .dequeue = backfill_dequeue,
+    .pick_next = backfill_pick_next,
+    .put_prev = backfill_put_prev,
+    .tick = backfill_tick,
+    .check_preempt = backfill_check_preempt,
+    .has_queued = backfill_has_queued,
+    .gang = true,
+};
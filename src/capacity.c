@@ -0,0 +1,140 @@
+#include "../lib/capacity.h"
+#include "../lib/scheduler.h"
+#include "../lib/smt.h"
+#include "../lib/log.h"
+#include <stdio.h>
+
+/**
+ * CPUs heterogêneas
+ * - A capacidade média das CPUs do processo é publicada no PCB a cada ciclo
+ *   (como o rendimento SMT) e as threads a aplicam no fim do bloco
+ * - Pesado: trabalho restante de pelo menos misfit ms
+ * - Sem capacity_aware o despacho ignora as capacidades (ordem de índice ou
+ *   afinidade), que é a base de comparação
+ */
+
+static long last_account_ms;    // Última amostragem (-1 = nenhuma)
+static CapacityStats stats;
+
+static int max_capacity(void) {
+    int best = 0;
+    for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+        if (capacity_of(cpu) > best) {
+            best = capacity_of(cpu);
+        }
+    }
+    return best;
+}
+
+static bool is_heavy(const PCB* pcb) {
+    return pcb->remaining_time >= system_state.tunables.misfit_ms;
+}
+
+void capacity_init(void) {
+    last_account_ms = -1;
+    stats = (CapacityStats){ 0 };
+    
+    if (capacity_enabled()) {
+        char text[MAX_CPUS * 6 + 1];
+        int length = 0;
+        for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+            length += snprintf(text + length, sizeof(text) - length, cpu > 0 ? ",%d" : "%d", capacity_of(cpu));
+        }
+        add_log_message("Capacidades das CPUs (%%): %s\n", text);
+    }
+}
+
+int capacity_of(int cpu) {
+    return system_state.tunables.capacity_pct[cpu];
+}
+
+bool capacity_enabled(void) {
+    for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+        if (capacity_of(cpu) != 100) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int capacity_select_cpu(const PCB* pcb, int cpu) {
+    if (!system_state.tunables.capacity_aware || !capacity_enabled()) {
+        return cpu;
+    }
+    
+    bool heavy = is_heavy(pcb);
+    int best = cpu;
+    for (int other = next_idle_cpu(0); other >= 0; other = next_idle_cpu(other + 1)) {
+        bool better = heavy ? capacity_of(other) > capacity_of(best) : capacity_of(other) < capacity_of(best);
+        if (better) {
+            best = other;
+        }
+    }
+    return best;
+}
+
+void capacity_publish(void) {
+    if (!capacity_enabled()) return;
+    
+    for (int cpu = next_running_process_cpu(0); cpu >= 0; cpu = next_running_process_cpu(cpu + 1)) {
+        PCB* process = system_state.current_process_array[cpu];
+        int held = cpus_of_process(process);
+        int capacity = 0;
+        for (CpuMask cpus = cpu_mask_of_process(process); cpus != 0; cpus &= cpus - 1) {
+            capacity += capacity_of(__builtin_ctzll(cpus));
+        }
+        pthread_mutex_lock(&process->mutex);
+        process->capacity_pct = capacity / held;
+        pthread_mutex_unlock(&process->mutex);
+    }
+}
+
+void capacity_migrate_misfits(const SchedClass* sched_class) {
+    if (!system_state.tunables.capacity_aware || !capacity_enabled() || sched_class->gang) return;
+    
+    for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+        PCB* process = system_state.current_process_array[cpu];
+        if (process == NULL || capacity_of(cpu) == max_capacity()) continue;
+        
+        pthread_mutex_lock(&process->mutex);
+        bool misfit = process->state == RUNNING && !process->should_preempt && is_heavy(process);
+        pthread_mutex_unlock(&process->mutex);
+        if (!misfit) continue;
+        
+        int target = cpu;
+        for (int other = 0; other < system_state.num_cpus; other++) {
+            bool idle = cpu_is_idle(other);
+            if (idle && capacity_of(other) > capacity_of(target) && core_sched_allows(process, other)) {
+                target = other;
+            }
+        }
+        if (target == cpu) continue;
+        
+        migrate_running_process(process, cpu, target);
+        stats.misfit_migrations++;
+        add_log_message("[CAPACIDADE] PID %d (restam %dms) migra da CPU %d (%d%%) para a CPU %d (%d%%)\n",
+                        process->pid, process->remaining_time, cpu, capacity_of(cpu), target, capacity_of(target));
+    }
+}
+
+void capacity_account(long now_ms) {
+    if (!capacity_enabled()) return;
+    
+    if (last_account_ms >= 0) {
+        long interval = now_ms - last_account_ms;
+        int biggest = max_capacity();
+        for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+            if (system_state.current_process_array[cpu] == NULL) continue;
+            
+            stats.busy_ms += interval;
+            if (capacity_of(cpu) == biggest) {
+                stats.big_ms += interval;
+            }
+        }
+    }
+    last_account_ms = now_ms;
+}
+
+void capacity_get_stats(CapacityStats* out) {
+    *out = stats;
+}
@@ -9,23 +9,31 @@
 
 // Estrutura principal do CFS
 typedef struct {
-    PCB* rb_root;                    // Raiz da Red-Black Tree
+    RBRoot rb_root;                  // Red-Black Tree ordenada por vruntime
     uint64_t min_vruntime;           // Menor vruntime na árvore
     uint64_t total_weight;           // Peso total dos processos
     int nr_running;                  // Número de processos executando
+    int nr_throttled;                // Processos fora da árvore aguardando recarga de quota
+    long clock_ms;                   // Último instante informado pelo escalonador
     pthread_mutex_t cfs_mutex;       // Mutex para thread safety
     int is_initialized;              // Flag de inicialização
 } CFSRunQueue;
 
 static CFSRunQueue cfs_rq = {
-    .rb_root = NULL,
+    .rb_root = RB_ROOT_INIT,
     .min_vruntime = 0,
     .total_weight = 0,
     .nr_running = 0,
+    .nr_throttled = 0,
+    .clock_ms = 0,
     .cfs_mutex = PTHREAD_MUTEX_INITIALIZER,
     .is_initialized = 0
 };
 
+// Pools de banda: um por grupo (índice = id do grupo) e um por processo com quota própria
+static CFSBandwidth group_pools[MAX_CGROUPS + 1];
+static CFSBandwidth process_pools[MAX_PROCESSES];
+
 /**
  * Tabela de pesos por prioridade (baseada no kernel Linux)
  */
@@ -41,14 +49,19 @@ static const int prio_to_weight[40] = {
 };
 
 /**
- * Função de comparação para vruntime (usada pela rbtree no modo monoprocessador)
- * No modo multiprocessador, usa fila simples por simplicidade
+ * Ordem da árvore: menor vruntime à esquerda (empates na ordem de inserção)
+ */
+static inline bool cfs_vruntime_less(const PCB* a, const PCB* b) {
+    return a->vruntime < b->vruntime;
+}
+
+RB_DEFINE_INSERT(cfs_timeline_insert, PCB, run_node, cfs_vruntime_less)
+
+/**
+ * Processo dono de um nó da árvore de vruntime
  */
-static int cfs_vruntime_compare(PCB* a, PCB* b) __attribute__((unused));
-static int cfs_vruntime_compare(PCB* a, PCB* b) {
-    if (a->vruntime < b->vruntime) return -1;
-    if (a->vruntime > b->vruntime) return 1;
-    return 0;
+static inline PCB* cfs_task_of(RBNode* node) {
+    return node ? rb_entry(node, PCB, run_node) : NULL;
 }
 
 /**
@@ -60,16 +73,32 @@ static int priority_to_weight(int priority) {
     return prio_to_weight[priority];
 }
 
+/**
+ * Período de escalonamento: sched_latency enquanto cada entidade couber
+ * com ao menos min_granularity; acima disso estica com nr_running
+ * (nr_running * min_granularity), como no kernel Linux
+ */
+static long cfs_sched_period(int nr_running) {
+    const SchedTunables* t = &system_state.tunables;
+    long nr_latency = t->sched_latency_us / t->sched_min_granularity_us;
+    
+    if (nr_running > nr_latency) {
+        return (long)nr_running * t->sched_min_granularity_us;
+    }
+    return t->sched_latency_us;
+}
+
 /**
  * Calcula timeslice baseado no peso do processo
+ * O processo selecionado já saiu da árvore, então entra na conta à parte
  */
 static int cfs_calculate_timeslice(PCB* process) {
-    const int sched_latency = 20000; // 20ms em microssegundos
-    
-    if (cfs_rq.total_weight == 0) return sched_latency;
+    const SchedTunables* t = &system_state.tunables;
+    int nr_running = cfs_rq.nr_running + 1;
+    uint64_t total_weight = cfs_rq.total_weight + process->weight;
     
-    int timeslice = (sched_latency * process->weight) / cfs_rq.total_weight;
-    return timeslice < 1000 ? 1000 : timeslice; // Mínimo 1ms
+    long timeslice = cfs_sched_period(nr_running) * process->weight / total_weight;
+    return timeslice < t->sched_min_granularity_us ? t->sched_min_granularity_us : timeslice;
 }
 
 /**
@@ -79,10 +108,166 @@ static void cfs_update_vruntime(PCB* process, uint64_t runtime_ns) {
     // vruntime cresce mais lentamente para processos com maior peso (maior prioridade)
     uint64_t weighted_runtime = (runtime_ns * 1024) / process->weight;
     process->vruntime += weighted_runtime;
+}
+
+/**
+ * Avança min_vruntime de forma monotônica até o menor vruntime entre
+ * o processo em execução (se houver) e o mais à esquerda da árvore
+ */
+static void cfs_update_min_vruntime(PCB* curr) {
+    PCB* leftmost = cfs_task_of(rb_leftmost(&cfs_rq.rb_root));
+    if (!curr && !leftmost) return;
+    
+    uint64_t vruntime;
+    if (!curr) {
+        vruntime = leftmost->vruntime;
+    } else if (!leftmost || curr->vruntime < leftmost->vruntime) {
+        vruntime = curr->vruntime;
+    } else {
+        vruntime = leftmost->vruntime;
+    }
+    
+    if (vruntime > cfs_rq.min_vruntime) {
+        cfs_rq.min_vruntime = vruntime;
+    }
+}
+
+/**
+ * Insere processo na árvore e atualiza estatísticas da runqueue
+ */
+static void cfs_tree_insert(PCB* process) {
+    process->run_node.rb_weight = process->weight;
+    cfs_timeline_insert(&cfs_rq.rb_root, process);
+    cfs_rq.total_weight += process->weight;
+    cfs_rq.nr_running++;
+}
+
+/**
+ * Remove processo da árvore e atualiza estatísticas da runqueue
+ */
+static void cfs_tree_remove(PCB* process) {
+    rb_remove(&cfs_rq.rb_root, &process->run_node);
+    if (cfs_rq.total_weight >= (uint64_t)process->weight) {
+        cfs_rq.total_weight -= process->weight;
+    }
+    if (cfs_rq.nr_running > 0) {
+        cfs_rq.nr_running--;
+    }
+}
+
+/**
+ * Prepara um pool de banda com quota cheia
+ */
+static void cfs_bandwidth_setup(CFSBandwidth* b, int id, int quota_ms) {
+    b->id = id;
+    b->quota_ms = quota_ms;
+    b->period_ms = system_state.tunables.cfs_period_ms;
+    b->runtime_remaining = quota_ms;
+    b->period_start_ms = 0;
+    b->throttled = 0;
+    b->throttle_start_ms = 0;
+    b->nr_throttled = 0;
+    b->throttled_time_ms = 0;
+    b->throttled_list = NULL;
+}
+
+/**
+ * Resolve o pool de banda de um processo: grupo tem precedência sobre quota própria
+ */
+static CFSBandwidth* cfs_bandwidth_of(PCB* process) {
+    if (process->cgroup_id > 0 && group_pools[process->cgroup_id].quota_ms > 0) {
+        return &group_pools[process->cgroup_id];
+    }
     
-    // Atualiza min_vruntime (simplificado para multiprocessador)
-    if ((uint64_t)process->vruntime < cfs_rq.min_vruntime) {
-        cfs_rq.min_vruntime = (uint64_t)process->vruntime;
+    int quota = process->cfs_quota_ms > 0 ? process->cfs_quota_ms : system_state.tunables.cfs_quota_ms;
+    if (quota <= 0) return NULL;
+    
+    CFSBandwidth* b = &process_pools[process->pid - 1];
+    if (b->quota_ms <= 0) {
+        cfs_bandwidth_setup(b, -process->pid, quota);
+    }
+    return b;
+}
+
+/**
+ * Retira processo da competição até a próxima recarga do seu pool
+ */
+static void cfs_park_throttled(PCB* process, long now_ms) {
+    CFSBandwidth* b = process->cfs_b;
+    process->throttled_next = b->throttled_list;
+    b->throttled_list = process;
+    process->throttle_count++;
+    process->throttle_start_ms = now_ms;
+    cfs_rq.nr_throttled++;
+}
+
+/**
+ * Coleta membros de um pool presentes na árvore (percurso em ordem)
+ */
+static int cfs_collect_members(CFSBandwidth* b, PCB** out) {
+    int count = 0;
+    for (RBNode* node = rb_leftmost(&cfs_rq.rb_root); node; node = rb_next(node)) {
+        PCB* process = cfs_task_of(node);
+        if (process->cfs_b == b) {
+            out[count++] = process;
+        }
+    }
+    return count;
+}
+
+/**
+ * Estrangula um pool: todos os seus membros deixam a árvore
+ */
+static void cfs_throttle_pool(CFSBandwidth* b, long now_ms) {
+    b->throttled = 1;
+    b->throttle_start_ms = now_ms;
+    b->nr_throttled++;
+    
+    PCB* members[MAX_PROCESSES];
+    int count = cfs_collect_members(b, members);
+    for (int i = 0; i < count; i++) {
+        cfs_tree_remove(members[i]);
+        cfs_park_throttled(members[i], now_ms);
+    }
+}
+
+/**
+ * Libera um pool recarregado: membros voltam à árvore sem vantagem de vruntime
+ */
+static void cfs_unthrottle_pool(CFSBandwidth* b, long now_ms) {
+    b->throttled = 0;
+    b->throttled_time_ms += now_ms - b->throttle_start_ms;
+    
+    while (b->throttled_list) {
+        PCB* process = b->throttled_list;
+        b->throttled_list = process->throttled_next;
+        process->throttled_next = NULL;
+        process->throttled_ms += now_ms - process->throttle_start_ms;
+        process->throttle_start_ms = -1;
+        if ((uint64_t)process->vruntime < cfs_rq.min_vruntime) {
+            process->vruntime = cfs_rq.min_vruntime;
+        }
+        cfs_tree_insert(process);
+        cfs_rq.nr_throttled--;
+    }
+}
+
+/**
+ * Avança os períodos vencidos de um pool, recarregando a quota
+ * A dívida de runtime (estouro do período anterior) é descontada da recarga
+ */
+static void cfs_bandwidth_refill(CFSBandwidth* b, long now_ms) {
+    if (b->quota_ms <= 0) return;
+    
+    while (now_ms >= b->period_start_ms + b->period_ms) {
+        b->period_start_ms += b->period_ms;
+        b->runtime_remaining += b->quota_ms;
+        if (b->runtime_remaining > b->quota_ms) {
+            b->runtime_remaining = b->quota_ms;
+        }
+    }
+    if (b->throttled && b->runtime_remaining > 0) {
+        cfs_unthrottle_pool(b, now_ms);
     }
 }
 
@@ -91,10 +276,18 @@ static void cfs_update_vruntime(PCB* process, uint64_t runtime_ns) {
 void cfs_init() {
     pthread_mutex_lock(&cfs_rq.cfs_mutex);
     if (!cfs_rq.is_initialized) {
-        cfs_rq.rb_root = NULL;
+        rb_init(&cfs_rq.rb_root);
         cfs_rq.min_vruntime = 0;
         cfs_rq.total_weight = 0;
         cfs_rq.nr_running = 0;
+        cfs_rq.nr_throttled = 0;
+        cfs_rq.clock_ms = 0;
+        for (int group = 1; group <= MAX_CGROUPS; group++) {
+            cfs_bandwidth_setup(&group_pools[group], group, system_state.tunables.cgroup_quota_ms[group]);
+        }
+        for (int i = 0; i < MAX_PROCESSES; i++) {
+            process_pools[i].quota_ms = -1;
+        }
         cfs_rq.is_initialized = 1;
     }
     pthread_mutex_unlock(&cfs_rq.cfs_mutex);
@@ -113,39 +306,90 @@ void cfs_enqueue_process(PCB* process) {
     
     // Inicializa campos CFS
     process->weight = priority_to_weight(process->priority);
-    process->vruntime = cfs_rq.min_vruntime; // Novo processo inicia com min_vruntime
+    // Novo processo inicia com min_vruntime; quem acorda de E/S mantém a dívida acumulada
+    if (process->first_run_ms < 0 || (uint64_t)process->vruntime < cfs_rq.min_vruntime) {
+        process->vruntime = cfs_rq.min_vruntime;
+    }
+    process->cfs_b = cfs_bandwidth_of(process);
     
-    // Insere na Red-Black Tree
-    rb_insert(&cfs_rq.rb_root, process, cfs_vruntime_compare);
-    // Atualiza estatísticas
-    cfs_rq.total_weight += process->weight;
-    cfs_rq.nr_running++;
+    // Membro de pool estrangulado aguarda a recarga fora da árvore
+    if (process->cfs_b && process->cfs_b->throttled) {
+        cfs_park_throttled(process, cfs_rq.clock_ms);
+    } else {
+        cfs_tree_insert(process);
+    }
     
     pthread_mutex_unlock(&cfs_rq.cfs_mutex);
 }
 
+/* Processo está na árvore (e não na lista de estrangulados) */
+static bool cfs_in_tree(const PCB* process) {
+    return process->run_node.rb_parent || cfs_rq.rb_root.rb_node == &process->run_node;
+}
+
+/* Início da fatia do processo escolhido (chamar com cfs_mutex) */
+static void cfs_start_slice(PCB* next) {
+    next->slice_us = cfs_calculate_timeslice(next);
+    next->slice_exec_ms = 0;
+    cfs_update_min_vruntime(next);
+}
+
+/* Retira da árvore ou da lista de estrangulados do pool (chamar com cfs_mutex) */
+static void cfs_dequeue_locked(PCB* process) {
+    if (cfs_in_tree(process)) {
+        cfs_tree_remove(process);
+    } else if (process->cfs_b) {
+        // Processo estrangulado: retira da lista de espera do pool
+        for (PCB** link = &process->cfs_b->throttled_list; *link; link = &(*link)->throttled_next) {
+            if (*link == process) {
+                *link = process->throttled_next;
+                process->throttled_next = NULL;
+                process->throttled_ms += cfs_rq.clock_ms - process->throttle_start_ms;
+                process->throttle_start_ms = -1;
+                cfs_rq.nr_throttled--;
+                break;
+            }
+        }
+    }
+}
+
 PCB* cfs_pick_next() {
     pthread_mutex_lock(&cfs_rq.cfs_mutex);
     // Verifica se CFS foi inicializado ou árvore vazia
-    if (!cfs_rq.is_initialized || rb_is_empty(cfs_rq.rb_root)) {
+    if (!cfs_rq.is_initialized || rb_is_empty(&cfs_rq.rb_root)) {
         pthread_mutex_unlock(&cfs_rq.cfs_mutex);
         return NULL;
     }
     // Seleciona o nó mais à esquerda (menor vruntime)
-    PCB* next = rb_leftmost(cfs_rq.rb_root);
+    PCB* next = cfs_task_of(rb_leftmost(&cfs_rq.rb_root));
     if (next != NULL) {
-        rb_remove(&cfs_rq.rb_root, next);
-        if (cfs_rq.total_weight >= (uint64_t)next->weight) {
-            cfs_rq.total_weight -= next->weight;
-        }
-        if (cfs_rq.nr_running > 0) {
-            cfs_rq.nr_running--;
-        }
+        cfs_tree_remove(next);
+        cfs_start_slice(next);
     }
     pthread_mutex_unlock(&cfs_rq.cfs_mutex);
     return next;
 }
 
+void cfs_pick_process(PCB* process) {
+    if (!process) return;
+    
+    pthread_mutex_lock(&cfs_rq.cfs_mutex);
+    // Só da árvore: processo estrangulado espera a recarga do pool
+    if (cfs_rq.is_initialized && cfs_in_tree(process)) {
+        cfs_tree_remove(process);
+        cfs_start_slice(process);
+    }
+    pthread_mutex_unlock(&cfs_rq.cfs_mutex);
+}
+
+void cfs_dequeue_process(PCB* process) {
+    if (!process) return;
+    
+    pthread_mutex_lock(&cfs_rq.cfs_mutex);
+    cfs_dequeue_locked(process);
+    pthread_mutex_unlock(&cfs_rq.cfs_mutex);
+}
+
 void cfs_put_prev_process(PCB* process, uint64_t runtime_ns) {
     if (!process) return;
     
@@ -157,14 +401,17 @@ void cfs_put_prev_process(PCB* process, uint64_t runtime_ns) {
         return;
     }
     
-    // Atualiza vruntime baseado no tempo executado
+    // Atualiza vruntime baseado no tempo executado (além do já cobrado em cfs_charge_runtime)
     cfs_update_vruntime(process, runtime_ns);
+    cfs_update_min_vruntime(process);
     
-    // Se processo ainda tem tempo, reinsere na árvore
+    // Se processo ainda tem tempo, reinsere na árvore (ou aguarda recarga se estrangulado)
     if (process->remaining_time > 0) {
-        rb_insert(&cfs_rq.rb_root, process, cfs_vruntime_compare);
-        cfs_rq.total_weight += process->weight;
-        cfs_rq.nr_running++;
+        if (process->cfs_b && process->cfs_b->throttled) {
+            cfs_park_throttled(process, cfs_rq.clock_ms);
+        } else {
+            cfs_tree_insert(process);
+        }
     }
     
     pthread_mutex_unlock(&cfs_rq.cfs_mutex);
@@ -172,14 +419,111 @@ void cfs_put_prev_process(PCB* process, uint64_t runtime_ns) {
 
 int cfs_get_timeslice(PCB* process) {
     pthread_mutex_lock(&cfs_rq.cfs_mutex);
-    int timeslice = cfs_calculate_timeslice(process);
+    int timeslice = process->slice_us;
     pthread_mutex_unlock(&cfs_rq.cfs_mutex);
     return timeslice;
 }
 
+bool cfs_charge_runtime(PCB* process, long now_ms) {
+    if (!process) return false;
+    
+    // Runtime consumido desde a última contabilização
+    pthread_mutex_lock(&process->mutex);
+    int consumed = process->runtime_snapshot - process->remaining_time;
+    process->runtime_snapshot = process->remaining_time;
+    pthread_mutex_unlock(&process->mutex);
+    
+    pthread_mutex_lock(&cfs_rq.cfs_mutex);
+    cfs_rq.clock_ms = now_ms;
+    
+    // Runtime real alimenta o vruntime e a fatia da execução atual
+    if (consumed > 0) {
+        cfs_update_vruntime(process, (uint64_t)consumed * 1000000);
+        cfs_update_min_vruntime(process);
+        process->slice_exec_ms += consumed;
+    }
+    
+    CFSBandwidth* b = process->cfs_b;
+    if (!b) {
+        pthread_mutex_unlock(&cfs_rq.cfs_mutex);
+        return false;
+    }
+    cfs_bandwidth_refill(b, now_ms);
+    b->runtime_remaining -= consumed;
+    if (b->runtime_remaining <= 0 && !b->throttled) {
+        cfs_throttle_pool(b, now_ms);
+    }
+    bool throttled = b->throttled;
+    pthread_mutex_unlock(&cfs_rq.cfs_mutex);
+    
+    return throttled;
+}
+
+bool cfs_slice_expired(PCB* process, int lookahead_ms) {
+    if (!process) return false;
+    
+    pthread_mutex_lock(&cfs_rq.cfs_mutex);
+    long slice_ms = process->slice_us / 1000L;
+    if (lookahead_ms > 0) {
+        // Threads só param na fronteira do bloco: fatia em blocos inteiros (mais próximo, mínimo 1)
+        long blocks = (process->slice_us + lookahead_ms * 500L) / (lookahead_ms * 1000L);
+        slice_ms = (blocks < 1 ? 1 : blocks) * lookahead_ms;
+    }
+    // Só preempta se houver com quem dividir a CPU
+    bool expired = cfs_rq.nr_running > 0 && process->slice_exec_ms + lookahead_ms >= slice_ms;
+    pthread_mutex_unlock(&cfs_rq.cfs_mutex);
+    return expired;
+}
+
+bool cfs_check_preempt_wakeup(PCB* curr) {
+    if (!curr) return false;
+    
+    pthread_mutex_lock(&cfs_rq.cfs_mutex);
+    bool preempt = false;
+    PCB* leftmost = cfs_task_of(rb_leftmost(&cfs_rq.rb_root));
+    if (leftmost != NULL) {
+        // Granularidade de wakeup convertida para vruntime do processo que acordou
+        int64_t gran_ns = (int64_t)system_state.tunables.sched_wakeup_granularity_us * 1000 * 1024 / leftmost->weight;
+        preempt = (curr->vruntime - leftmost->vruntime) > gran_ns;
+    }
+    pthread_mutex_unlock(&cfs_rq.cfs_mutex);
+    return preempt;
+}
+
+void cfs_bandwidth_refresh(long now_ms) {
+    pthread_mutex_lock(&cfs_rq.cfs_mutex);
+    if (cfs_rq.is_initialized) {
+        cfs_rq.clock_ms = now_ms;
+        for (int group = 1; group <= MAX_CGROUPS; group++) {
+            cfs_bandwidth_refill(&group_pools[group], now_ms);
+        }
+        for (int i = 0; i < MAX_PROCESSES; i++) {
+            cfs_bandwidth_refill(&process_pools[i], now_ms);
+        }
+    }
+    pthread_mutex_unlock(&cfs_rq.cfs_mutex);
+}
+
+void cfs_get_bandwidth_stats(int group, int* nr_throttled, long* throttled_ms) {
+    if (group < 1 || group > MAX_CGROUPS) return;
+    
+    pthread_mutex_lock(&cfs_rq.cfs_mutex);
+    if (nr_throttled) *nr_throttled = group_pools[group].nr_throttled;
+    if (throttled_ms) *throttled_ms = group_pools[group].throttled_time_ms;
+    pthread_mutex_unlock(&cfs_rq.cfs_mutex);
+}
+
+bool cfs_is_throttled(const PCB* process) {
+    pthread_mutex_lock(&cfs_rq.cfs_mutex);
+    bool throttled = process->cfs_b != NULL && process->cfs_b->throttled;
+    pthread_mutex_unlock(&cfs_rq.cfs_mutex);
+    return throttled;
+}
+
 bool cfs_has_processes() {
     pthread_mutex_lock(&cfs_rq.cfs_mutex);
-    bool has = (cfs_rq.nr_running > 0);
+    // Processos estrangulados ainda têm trabalho pendente
+    bool has = (cfs_rq.nr_running > 0 || cfs_rq.nr_throttled > 0);
     pthread_mutex_unlock(&cfs_rq.cfs_mutex);
     return has;
 }
@@ -187,14 +531,20 @@ bool cfs_has_processes() {
 void cfs_cleanup() {
     pthread_mutex_lock(&cfs_rq.cfs_mutex);
     // Limpa a árvore
-    while (!rb_is_empty(cfs_rq.rb_root)) {
-        PCB* node = rb_leftmost(cfs_rq.rb_root);
-        if (node) rb_remove(&cfs_rq.rb_root, node);
+    while (!rb_is_empty(&cfs_rq.rb_root)) {
+        rb_remove(&cfs_rq.rb_root, rb_leftmost(&cfs_rq.rb_root));
+    }
+    for (int group = 1; group <= MAX_CGROUPS; group++) {
+        group_pools[group].throttled_list = NULL;
+    }
+    for (int i = 0; i < MAX_PROCESSES; i++) {
+        process_pools[i].throttled_list = NULL;
     }
     cfs_rq.min_vruntime = 0;
     cfs_rq.total_weight = 0;
     cfs_rq.nr_running = 0;
+    cfs_rq.nr_throttled = 0;
     cfs_rq.is_initialized = 0;
+    // Mutex estático permanece válido para permitir nova inicialização
     pthread_mutex_unlock(&cfs_rq.cfs_mutex);
-    pthread_mutex_destroy(&cfs_rq.cfs_mutex);
 }
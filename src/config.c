@@ -0,0 +1,582 @@
+#include "config.h"
+#include "log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#define MAX_KEY_LEN 64
+
+void init_default_tunables(SchedTunables* tunables) {
+    if (tunables == NULL) return;
+    
+    tunables->cfs_period_ms = 100;
+    tunables->cfs_quota_ms = -1;
+    for (int i = 0; i <= MAX_CGROUPS; i++) {
+        tunables->cgroup_quota_ms[i] = -1;
+    }
+    tunables->sched_latency_us = 20000;
+    tunables->sched_min_granularity_us = 1000;
+    tunables->sched_wakeup_granularity_us = 1000;
+    
+    // MLFQ: 3 níveis com quantum dobrando a cada nível
+    tunables->mlfq_levels = 3;
+    for (int level = 0; level < MLFQ_MAX_LEVELS; level++) {
+        tunables->mlfq_quantum_ms[level] = THREAD_EXECUTION_TIME << level;
+    }
+    tunables->mlfq_boost_ms = 3000;
+    tunables->priority_aging_ms = 1000;
+    tunables->lottery_seed = 1;
+    tunables->slo_pressure_ms = 1000;
+    tunables->adaptive_window_ms = 2000;
+    tunables->adaptive_burst = 3;
+    tunables->adaptive_scv_pct = 100;
+    tunables->gang_slot_ms = 1000;
+    tunables->cpus = 2;
+    tunables->easy_backfill = 1;
+    tunables->bsld_tau_ms = 1000;
+    tunables->amdahl = 0;
+    tunables->serial_pct = 10;
+    tunables->thread_sched = 0;
+    tunables->cs_cost_ms = 0;
+    tunables->migration_cost_ms = 0;
+    tunables->rr_quantum_ms = THREAD_EXECUTION_TIME;
+    tunables->affinity = 0;
+    tunables->cache_decay_ms = 0;
+    tunables->affinity_imbalance = 0;
+    
+    // Sem topologia; com ela, migrações entre LLCs e entre nós são raras
+    tunables->topo_nodes = 0;
+    tunables->topo_llcs = 1;
+    tunables->topo_cores = 1;
+    tunables->topo_smt = 1;
+    for (int level = 0; level < TOPO_LEVELS; level++) {
+        tunables->domain_cost_ms[level] = -1;
+        tunables->balance_ms[level] = 0;
+    }
+    tunables->balance_ms[TOPO_NODE] = 1000;
+    tunables->balance_ms[TOPO_NUMA] = 4000;
+    tunables->smt = 0;
+    tunables->smt_share_pct = 60;
+    tunables->core_sched = 0;
+    
+    // CPUs homogêneas; com capacity=, a colocação ignora as capacidades até capacity_aware=1
+    for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
+        tunables->capacity_pct[cpu] = 100;
+    }
+    tunables->capacity_aware = 0;
+    tunables->misfit_ms = 2000;
+    tunables->hotplug_count = 0;
+    tunables->hotplug_ctl[0] = '\0';
+    
+    // Tempo real: até 75% de cada CPU (3 blocos a cada 2 s)
+    tunables->rt_period_ms = 2000;
+    tunables->rt_runtime_ms = 1500;
+    tunables->rt_rr_quantum_ms = 1000;
+}
+
+/* Converte texto para inteiro, rejeitando lixo ao final */
+static int parse_int(const char* text, int* out) {
+    char* end = NULL;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0') {
+        return 0;
+    }
+    *out = (int)value;
+    return 1;
+}
+
+/* Converte política por número (1..15) ou nome (FCFS, RR, ...) */
+static int parse_policy(const char* text, SchedulerType* out) {
+    int number;
+    if (parse_int(text, &number)) {
+        if (number < FCFS || number > BACKFILL) return 0;
+        *out = (SchedulerType)number;
+        return 1;
+    }
+    for (int type = FCFS; type <= BACKFILL; type++) {
+        if (strcasecmp(text, get_scheduler_name((SchedulerType)type)) == 0) {
+            *out = (SchedulerType)type;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Nível da topologia pelo nome (smt, llc, node, numa); -1 se inválido */
+static int parse_topo_level(const char* text) {
+    static const char* names[TOPO_LEVELS] = { NULL, "smt", "llc", "node", "numa" };
+    for (int level = TOPO_SMT; level < TOPO_LEVELS; level++) {
+        if (strcmp(text, names[level]) == 0) {
+            return level;
+        }
+    }
+    return -1;
+}
+
+/* Formato: <nivel>:<ms>, nível smt, llc, node ou numa */
+static int parse_level_ms(const char* value, int* level, int* ms) {
+    char name[16];
+    if (sscanf(value, "%15[a-z]:%d", name, ms) != 2 || *ms < 0) {
+        return 0;
+    }
+    *level = parse_topo_level(name);
+    return *level >= 0;
+}
+
+/**
+ * Capacidades das CPUs: capacity=C0,C1,...
+ * Em % da CPU de referência (1..1000); CPUs não listadas ficam com 100
+ */
+static int parse_capacities(SchedTunables* t, const char* value) {
+    int capacity[MAX_CPUS];
+    int count = 0;
+    const char* cursor = value;
+    while (*cursor != '\0') {
+        int pct, consumed;
+        if (count == MAX_CPUS || sscanf(cursor, "%d%n", &pct, &consumed) != 1 || pct < 1 || pct > 1000) {
+            return 0;
+        }
+        capacity[count++] = pct;
+        
+        cursor += consumed;
+        if (*cursor == ',') {
+            cursor++;
+        } else if (*cursor != '\0') {
+            return 0;
+        }
+    }
+    if (count == 0) return 0;
+    for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
+        t->capacity_pct[cpu] = cpu < count ? capacity[cpu] : 100;
+    }
+    return 1;
+}
+
+/**
+ * Hotplug agendado: hotplug=MS:CPU:on|off[,...]
+ * Acrescenta aos eventos já agendados, mantendo a ordem por instante; a CPU
+ * é conferida com o número de CPUs quando o evento acontece
+ */
+static int parse_hotplug(SchedTunables* t, const char* value) {
+    const char* cursor = value;
+    while (*cursor != '\0') {
+        long at_ms;
+        int cpu, consumed;
+        char state[4];
+        if (t->hotplug_count == MAX_HOTPLUG_EVENTS ||
+            sscanf(cursor, "%ld:%d:%3[a-z]%n", &at_ms, &cpu, state, &consumed) != 3 ||
+            at_ms < 0 || cpu < 0 || cpu >= MAX_CPUS) {
+            return 0;
+        }
+        int online;
+        if (strcmp(state, "on") == 0) {
+            online = 1;
+        } else if (strcmp(state, "off") == 0) {
+            online = 0;
+        } else {
+            return 0;
+        }
+        
+        int pos = t->hotplug_count++;
+        while (pos > 0 && t->hotplug_at_ms[pos - 1] > at_ms) {
+            t->hotplug_at_ms[pos] = t->hotplug_at_ms[pos - 1];
+            t->hotplug_cpu[pos] = t->hotplug_cpu[pos - 1];
+            t->hotplug_online[pos] = t->hotplug_online[pos - 1];
+            pos--;
+        }
+        t->hotplug_at_ms[pos] = at_ms;
+        t->hotplug_cpu[pos] = cpu;
+        t->hotplug_online[pos] = online;
+        
+        cursor += consumed;
+        if (*cursor == ',') {
+            cursor++;
+        } else if (*cursor != '\0') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Opções que ajustam parâmetros globais da simulação */
+static int apply_global_option(const char* key, const char* value) {
+    SchedTunables* t = &system_state.tunables;
+    int number;
+    
+    if (strcmp(key, "cfs_period") == 0) {
+        if (!parse_int(value, &number) || number <= 0) return 0;
+        t->cfs_period_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "cfs_quota") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        t->cfs_quota_ms = number > 0 ? number : -1;
+        return 1;
+    }
+    if (strcmp(key, "sched_latency_us") == 0) {
+        if (!parse_int(value, &number) || number <= 0) return 0;
+        t->sched_latency_us = number;
+        return 1;
+    }
+    if (strcmp(key, "sched_min_granularity_us") == 0) {
+        if (!parse_int(value, &number) || number <= 0) return 0;
+        t->sched_min_granularity_us = number;
+        return 1;
+    }
+    if (strcmp(key, "sched_wakeup_granularity_us") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->sched_wakeup_granularity_us = number;
+        return 1;
+    }
+    if (strcmp(key, "policy") == 0) {
+        SchedulerType type;
+        if (!parse_policy(value, &type)) return 0;
+        system_state.scheduler_type = type;
+        return 1;
+    }
+    if (strcmp(key, "mlfq_levels") == 0) {
+        if (!parse_int(value, &number) || number < 1 || number > MLFQ_MAX_LEVELS) return 0;
+        t->mlfq_levels = number;
+        return 1;
+    }
+    if (strcmp(key, "mlfq_quantum") == 0) {
+        // Formato: mlfq_quantum=<nivel>:<quantum_ms>
+        int level, quantum;
+        if (sscanf(value, "%d:%d", &level, &quantum) != 2 || level < 0 ||
+            level >= MLFQ_MAX_LEVELS || quantum <= 0) {
+            return 0;
+        }
+        t->mlfq_quantum_ms[level] = quantum;
+        return 1;
+    }
+    if (strcmp(key, "mlfq_boost") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->mlfq_boost_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "priority_aging") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->priority_aging_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "slo_pressure") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->slo_pressure_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "adaptive_window") == 0) {
+        if (!parse_int(value, &number) || number <= 0) return 0;
+        t->adaptive_window_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "adaptive_burst") == 0) {
+        if (!parse_int(value, &number) || number <= 0) return 0;
+        t->adaptive_burst = number;
+        return 1;
+    }
+    if (strcmp(key, "adaptive_scv") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->adaptive_scv_pct = number;
+        return 1;
+    }
+    if (strcmp(key, "gang_slot") == 0) {
+        if (!parse_int(value, &number) || number <= 0) return 0;
+        t->gang_slot_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "cpus") == 0) {
+        if (!parse_int(value, &number) || number < 1 || number > MAX_CPUS) return 0;
+        t->cpus = number;
+        return 1;
+    }
+    if (strcmp(key, "backfill") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        t->easy_backfill = number != 0;
+        return 1;
+    }
+    if (strcmp(key, "bsld_tau") == 0) {
+        if (!parse_int(value, &number) || number <= 0) return 0;
+        t->bsld_tau_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "amdahl") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        t->amdahl = number != 0;
+        return 1;
+    }
+    if (strcmp(key, "serial") == 0) {
+        if (!parse_int(value, &number) || number < 0 || number > 100) return 0;
+        t->serial_pct = number;
+        return 1;
+    }
+    if (strcmp(key, "cs_cost") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->cs_cost_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "migration_cost") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->migration_cost_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "rr_quantum") == 0) {
+        // O quantum é medido em blocos inteiros de execução
+        if (!parse_int(value, &number) || number < THREAD_EXECUTION_TIME ||
+            number % THREAD_EXECUTION_TIME != 0) {
+            return 0;
+        }
+        t->rr_quantum_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "affinity") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        t->affinity = number != 0;
+        return 1;
+    }
+    if (strcmp(key, "cache_decay") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->cache_decay_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "affinity_imbalance") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->affinity_imbalance = number;
+        return 1;
+    }
+    if (strcmp(key, "topology") == 0) {
+        // Formato: topology=<nós>:<LLCs por nó>:<núcleos por LLC>:<threads por núcleo>
+        int nodes, llcs, cores, smt;
+        if (sscanf(value, "%d:%d:%d:%d", &nodes, &llcs, &cores, &smt) != 4 || nodes < 1 ||
+            llcs < 1 || cores < 1 || smt < 1 || nodes * llcs * cores * smt > MAX_CPUS) {
+            return 0;
+        }
+        t->topo_nodes = nodes;
+        t->topo_llcs = llcs;
+        t->topo_cores = cores;
+        t->topo_smt = smt;
+        return 1;
+    }
+    if (strcmp(key, "domain_cost") == 0) {
+        int level, ms;
+        if (!parse_level_ms(value, &level, &ms)) return 0;
+        t->domain_cost_ms[level] = ms;
+        return 1;
+    }
+    if (strcmp(key, "balance") == 0) {
+        int level, ms;
+        if (!parse_level_ms(value, &level, &ms)) return 0;
+        t->balance_ms[level] = ms;
+        return 1;
+    }
+    if (strcmp(key, "smt") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        t->smt = number != 0;
+        return 1;
+    }
+    if (strcmp(key, "smt_share") == 0) {
+        if (!parse_int(value, &number) || number < 1 || number > 100) return 0;
+        t->smt_share_pct = number;
+        return 1;
+    }
+    if (strcmp(key, "core_sched") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        t->core_sched = number != 0;
+        return 1;
+    }
+    if (strcmp(key, "capacity") == 0) {
+        return parse_capacities(t, value);
+    }
+    if (strcmp(key, "capacity_aware") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        t->capacity_aware = number != 0;
+        return 1;
+    }
+    if (strcmp(key, "misfit") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->misfit_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "hotplug") == 0) {
+        return parse_hotplug(t, value);
+    }
+    if (strcmp(key, "hotplug_ctl") == 0) {
+        if (value[0] == '\0' || strlen(value) >= sizeof(t->hotplug_ctl)) return 0;
+        strcpy(t->hotplug_ctl, value);
+        return 1;
+    }
+    if (strcmp(key, "thread_sched") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        t->thread_sched = number != 0;
+        return 1;
+    }
+    if (strcmp(key, "rt_period") == 0) {
+        if (!parse_int(value, &number) || number <= 0) return 0;
+        t->rt_period_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "rt_runtime") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        t->rt_runtime_ms = number >= 0 ? number : -1;
+        return 1;
+    }
+    if (strcmp(key, "rt_rr_quantum") == 0) {
+        if (!parse_int(value, &number) || number <= 0) return 0;
+        t->rt_rr_quantum_ms = number;
+        return 1;
+    }
+    if (strcmp(key, "lottery_seed") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        t->lottery_seed = (unsigned int)number;
+        return 1;
+    }
+    if (strcmp(key, "cgroup_quota") == 0) {
+        // Formato: cgroup_quota=<grupo>:<quota_ms>
+        int group, quota;
+        if (sscanf(value, "%d:%d", &group, &quota) != 2 || group < 1 || group > MAX_CGROUPS) {
+            return 0;
+        }
+        t->cgroup_quota_ms[group] = quota > 0 ? quota : -1;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Rajadas de E/S: io=CPU:IO[,CPU:IO...]
+ * Cada par executa CPU ms de trabalho e então bloqueia IO ms no dispositivo;
+ * depois da última rajada o restante do trabalho é só CPU
+ */
+static int parse_io_bursts(PCB* pcb, const char* value) {
+    int count = 0;
+    int executed = 0;
+    const char* cursor = value;
+    while (*cursor != '\0') {
+        int cpu_ms, io_ms, consumed;
+        if (count == MAX_IO_BURSTS || sscanf(cursor, "%d:%d%n", &cpu_ms, &io_ms, &consumed) != 2 ||
+            cpu_ms <= 0 || io_ms <= 0) {
+            return 0;
+        }
+        executed += cpu_ms;
+        pcb->io_at_ms[count] = executed;
+        pcb->io_ms[count] = io_ms;
+        count++;
+        
+        cursor += consumed;
+        if (*cursor == ',') {
+            cursor++;
+        } else if (*cursor != '\0') {
+            return 0;
+        }
+    }
+    if (count == 0) return 0;
+    pcb->io_count = count;
+    pcb->io_next = 0;
+    return 1;
+}
+
+/* Opções que ajustam um processo específico (após pid=N) */
+static int apply_process_option(PCB* pcb, const char* key, const char* value) {
+    int number;
+    
+    if (strcmp(key, "cfs_quota") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        pcb->cfs_quota_ms = number > 0 ? number : -1;
+        return 1;
+    }
+    if (strcmp(key, "cgroup") == 0) {
+        if (!parse_int(value, &number) || number < 0 || number > MAX_CGROUPS) return 0;
+        pcb->cgroup_id = number;
+        return 1;
+    }
+    if (strcmp(key, "class") == 0) {
+        if (strcasecmp(value, "fifo") == 0) {
+            pcb->rt_policy = RT_POLICY_FIFO;
+        } else if (strcasecmp(value, "rr") == 0) {
+            pcb->rt_policy = RT_POLICY_RR;
+        } else if (strcasecmp(value, "normal") == 0) {
+            pcb->rt_policy = RT_POLICY_NORMAL;
+        } else {
+            return 0;
+        }
+        return 1;
+    }
+    if (strcmp(key, "rt_priority") == 0) {
+        if (!parse_int(value, &number) || number < 1 || number >= RT_MAX_PRIO) return 0;
+        pcb->rt_priority = number;
+        return 1;
+    }
+    if (strcmp(key, "tickets") == 0) {
+        if (!parse_int(value, &number) || number <= 0) return 0;
+        pcb->tickets = number;
+        return 1;
+    }
+    if (strcmp(key, "slo") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        pcb->slo_ms = number > 0 ? number : -1;
+        return 1;
+    }
+    if (strcmp(key, "deadline") == 0) {
+        if (!parse_int(value, &number)) return 0;
+        pcb->rel_deadline_ms = number > 0 ? number : -1;
+        return 1;
+    }
+    if (strcmp(key, "serial") == 0) {
+        if (!parse_int(value, &number) || number < 0 || number > 100) return 0;
+        pcb->serial_pct = number;
+        return 1;
+    }
+    if (strcmp(key, "io") == 0) {
+        return parse_io_bursts(pcb, value);
+    }
+    if (strcmp(key, "trust") == 0) {
+        if (!parse_int(value, &number) || number < 0) return 0;
+        pcb->trust_group = number;
+        return 1;
+    }
+    if (strcmp(key, "siblings") == 0) {
+        if (strcasecmp(value, "close") == 0) {
+            pcb->siblings_spread = 0;
+        } else if (strcasecmp(value, "spread") == 0) {
+            pcb->siblings_spread = 1;
+        } else {
+            return 0;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+int apply_config_option(const char* token, PCB** scope) {
+    if (token == NULL || scope == NULL) return 0;
+    
+    const char* separator = strchr(token, '=');
+    if (separator == NULL || separator == token || separator - token >= MAX_KEY_LEN) {
+        add_log_message("ERRO: Opcao invalida (esperado chave=valor): %s\n", token);
+        return 0;
+    }
+    
+    char key[MAX_KEY_LEN];
+    memcpy(key, token, separator - token);
+    key[separator - token] = '\0';
+    const char* value = separator + 1;
+    
+    // pid=N seleciona o processo alvo das opções seguintes
+    if (strcmp(key, "pid") == 0) {
+        int pid;
+        if (!parse_int(value, &pid) || pid < 1 || pid > system_state.process_count) {
+            add_log_message("ERRO: PID invalido na opcao: %s\n", token);
+            return 0;
+        }
+        *scope = &system_state.pcb_list[pid - 1];
+        return 1;
+    }
+    
+    // Opções por processo têm precedência quando há processo selecionado
+    int applied = (*scope != NULL && apply_process_option(*scope, key, value)) ||
+                  apply_global_option(key, value);
+    if (!applied) {
+        add_log_message("ERRO: Opcao desconhecida ou valor invalido: %s\n", token);
+    }
+    return applied;
+}
@@ -0,0 +1,134 @@
+#include "../lib/sched_class.h"
+#include "../lib/scheduler.h"
+#include "../lib/rbtree.h"
+#include "../lib/log.h"
+#include <limits.h>
+#include <stdio.h>
+
+/**
+ * Earliest Deadline First
+ * - Processos prontos ficam em uma Red-Black Tree ordenada pelo deadline
+ *   absoluto (chegada + deadline relativo); o mais urgente é o leftmost (O(1))
+ * - Processos sem deadline ficam no fim da árvore (executam em segundo plano)
+ * - Chegada com deadline anterior ao do processo em execução o preempta
+ *   na fronteira do bloco
+ * - Admissão: utilização sum(duracao / deadline) <= número de CPUs
+ */
+
+static RBRoot deadline_tree = RB_ROOT_INIT;
+
+static inline bool edf_deadline_less(const PCB* a, const PCB* b) {
+    return a->abs_deadline_ms < b->abs_deadline_ms;
+}
+
+RB_DEFINE_INSERT(edf_tree_insert, PCB, dl_node, edf_deadline_less)
+
+static inline PCB* edf_task_of(RBNode* node) {
+    return node ? rb_entry(node, PCB, dl_node) : NULL;
+}
+
+static bool edf_on_tree(PCB* process) {
+    return process->dl_node.rb_parent != NULL || deadline_tree.rb_node == &process->dl_node;
+}
+
+static void edf_init(void) {
+    rb_init(&deadline_tree);
+}
+
+static void edf_exit(void) {
+    rb_init(&deadline_tree);
+}
+
+static void edf_enqueue(PCB* process) {
+    process->abs_deadline_ms = process->rel_deadline_ms > 0
+                             ? (long)process->start_time + process->rel_deadline_ms
+                             : LONG_MAX;
+    edf_tree_insert(&deadline_tree, process);
+}
+
+static void edf_dequeue(PCB* process) {
+    if (edf_on_tree(process)) {
+        rb_remove(&deadline_tree, &process->dl_node);
+    }
+}
+
+static PCB* edf_pick_next(void) {
+    PCB* process = edf_task_of(rb_leftmost(&deadline_tree));
+    if (process != NULL) {
+        rb_remove(&deadline_tree, &process->dl_node);
+    }
+    return process;
+}
+
+static void edf_put_prev(PCB* process) {
+    edf_tree_insert(&deadline_tree, process);
+}
+
+static bool edf_no_tick(PCB* curr, long now_ms) {
+    (void)curr;
+    (void)now_ms;
+    return false;
+}
+
+static bool edf_check_preempt(PCB* curr) {
+    PCB* earliest = edf_task_of(rb_leftmost(&deadline_tree));
+    if (earliest == NULL || !edf_deadline_less(earliest, curr)) {
+        return false;
+    }
+    add_log_message("[EDF] Processo PID %d preemptado por PID %d (deadline %ldms)\n",
+                    curr->pid, earliest->pid, earliest->abs_deadline_ms);
+    return true;
+}
+
+static bool edf_has_queued(void) {
+    return !rb_is_empty(&deadline_tree);
+}
+
+/**
+ * Teste de utilização: cada processo com deadline contribui tempo de parede / deadline
+ * (as threads executam em paralelo, então a duração em parede cai com elas)
+ */
+static bool edf_admit(void) {
+    double utilisation = 0.0;
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        if (pcb->rel_deadline_ms > 0) {
+            utilisation += (double)process_service_time_ms(pcb, pcb->process_len) / pcb->rel_deadline_ms;
+        }
+    }
+
+    add_log_message("[EDF] Utilizacao %.3f com %d CPU(s)\n", utilisation, system_state.num_cpus);
+    if (utilisation > system_state.num_cpus) {
+        fprintf(stderr, "ERRO: Utilizacao %.3f excede o numero de CPUs (%d)\n",
+                utilisation, system_state.num_cpus);
+        return false;
+    }
+    return true;
+}
+
+static void edf_log_dispatch(PCB* process, int cpu) {
+    if (process->rel_deadline_ms > 0) {
+        add_log_message("[EDF] Processo PID %d com deadline em %ldms\n", process->pid, process->abs_deadline_ms);
+    }
+#ifdef MULTI
+    log_process_start_cpu("EDF", process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start("EDF", process->pid);
+#endif
+}
+
+const SchedClass edf_sched_class = {
+    .name = "EDF",
+    .init = edf_init,
+    .exit = edf_exit,
+    .enqueue = edf_enqueue,
+    .dequeue = edf_dequeue,
+    .pick_next = edf_pick_next,
+    .put_prev = edf_put_prev,
+    .tick = edf_no_tick,
+    .check_preempt = edf_check_preempt,
+    .has_queued = edf_has_queued,
+    .admit = edf_admit,
+    .log_dispatch = edf_log_dispatch,
+};
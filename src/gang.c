@@ -0,0 +1,254 @@
+#include "../lib/sched_class.h"
+#include "../lib/scheduler.h"
+#include "../lib/log.h"
+#include <stdlib.h>
+
+/**
+ * Gang scheduling com a matriz de Ousterhout (política GANG)
+ * - Colunas são CPUs e linhas são fatias de tempo; cada processo ocupa
+ *   min(num_threads, num_cpus) colunas de uma única linha (first fit)
+ * - A cada fatia (gang_slot ms) uma linha é despachada inteira: todas as
+ *   threads de cada processo da linha entram juntas em CPUs distintas e saem
+ *   juntas no fim da fatia
+ * - Custo medido: colunas vazias da linha (fragmentação) e CPUs que ficam
+ *   ociosas dentro da fatia porque um processo do gang terminou antes dela
+ *   acabar (sincronização)
+ */
+
+typedef struct {
+    PCB* cols[MAX_CPUS];        // Processo dono de cada coluna (NULL = livre)
+    int used;                   // Colunas ocupadas
+} GangRow;
+
+static GangRow* matrix;         // Uma linha por processo no pior caso
+static int nr_rows;             // Linhas em uso (vazias do fim são descartadas)
+static int placed;              // Processos na matriz
+static int current_row;         // Linha da fatia atual
+static int row_next_col;        // Próxima coluna da linha atual a despachar
+static int row_running;         // Processos da linha atual em CPU
+static int slot_width;          // Colunas despachadas na fatia atual
+static long slot_start_ms;      // Início da fatia atual (-1 = não começou)
+static long last_leave_ms;      // Última saída de CPU (fecha a fatia final)
+static GangStats stats;
+
+static int gang_width(const PCB* process) {
+    return process->num_threads < system_state.num_cpus ? process->num_threads : system_state.num_cpus;
+}
+
+/* Coloca o processo na primeira linha com colunas livres suficientes */
+static void gang_place(PCB* process) {
+    int width = gang_width(process);
+    int row = 0;
+    while (row < nr_rows && system_state.num_cpus - matrix[row].used < width) {
+        row++;
+    }
+    if (row == nr_rows) {
+        nr_rows++;
+        if (nr_rows > stats.max_rows) {
+            stats.max_rows = nr_rows;
+        }
+    }
+    
+    process->gang_row = row;
+    process->gang_col = -1;
+    int taken = 0;
+    for (int col = 0; col < system_state.num_cpus && taken < width; col++) {
+        if (matrix[row].cols[col] == NULL) {
+            matrix[row].cols[col] = process;
+            if (process->gang_col < 0) {
+                process->gang_col = col;
+            }
+            taken++;
+        }
+    }
+    matrix[row].used += width;
+    placed++;
+    add_log_message("[GANG] Processo PID %d na linha %d (%d coluna(s) a partir da %d)\n",
+                    process->pid, row, width, process->gang_col);
+}
+
+/* Libera as colunas do processo; linhas vazias do fim saem da matriz */
+static void gang_unplace(PCB* process) {
+    GangRow* row = &matrix[process->gang_row];
+    for (int col = 0; col < system_state.num_cpus; col++) {
+        if (row->cols[col] == process) {
+            row->cols[col] = NULL;
+        }
+    }
+    row->used -= gang_width(process);
+    process->gang_row = -1;
+    process->gang_col = -1;
+    placed--;
+    
+    while (nr_rows > 0 && matrix[nr_rows - 1].used == 0) {
+        nr_rows--;
+    }
+}
+
+/* Próximo processo da linha atual ainda não despachado nesta fatia */
+static PCB* gang_row_pending(void) {
+    if (current_row >= nr_rows) {
+        return NULL;
+    }
+    for (int col = row_next_col; col < system_state.num_cpus; col++) {
+        PCB* process = matrix[current_row].cols[col];
+        if (process != NULL && process->gang_col == col) {
+            return process;
+        }
+    }
+    return NULL;
+}
+
+/* Contabiliza a fatia: colunas nunca despachadas são fragmentação */
+static void gang_close_slot(long end_ms) {
+    if (slot_start_ms < 0) {
+        return;
+    }
+    long slot_ms = end_ms - slot_start_ms;
+    stats.slots++;
+    stats.capacity_ms += slot_ms * system_state.num_cpus;
+    stats.fragmented_ms += slot_ms * (system_state.num_cpus - slot_width);
+    slot_start_ms = -1;
+}
+
+/* Passa para a próxima linha com processos (circular) */
+static void gang_advance(long now_ms) {
+    gang_close_slot(now_ms);
+    for (int step = 1; step <= nr_rows; step++) {
+        int row = (current_row + step) % nr_rows;
+        if (matrix[row].used > 0) {
+            current_row = row;
+            break;
+        }
+    }
+    row_next_col = 0;
+    slot_width = 0;
+}
+
+/* Processo saiu da CPU (fim da fatia ou término) */
+static void gang_leave(PCB* process) {
+    if (process->gang_dispatch_ms < 0) {
+        return;
+    }
+    long now = calculate_elapsed_time();
+    stats.busy_ms += (now - process->gang_dispatch_ms) * gang_width(process);
+    process->gang_dispatch_ms = -1;
+    last_leave_ms = now;
+    row_running--;
+}
+
+/* Há outra linha esperando a vez (sem ela a fatia não precisa acabar) */
+static bool gang_other_rows_waiting(void) {
+    for (int row = 0; row < nr_rows; row++) {
+        if (row != current_row && matrix[row].used > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void gang_init(void) {
+    int rows = system_state.process_count > 0 ? system_state.process_count : 1;
+    matrix = calloc(rows, sizeof(GangRow));
+    nr_rows = 0;
+    placed = 0;
+    current_row = 0;
+    row_next_col = 0;
+    row_running = 0;
+    slot_width = 0;
+    slot_start_ms = -1;
+    last_leave_ms = 0;
+    stats = (GangStats){ 0 };
+}
+
+static void gang_exit(void) {
+    free(matrix);
+    matrix = NULL;
+}
+
+static void gang_enqueue(PCB* process) {
+    if (matrix != NULL) {
+        gang_place(process);
+    }
+}
+
+/* Processo terminou: sai da CPU e da matriz */
+static void gang_dequeue(PCB* process) {
+    gang_leave(process);
+    if (process->gang_row >= 0) {
+        gang_unplace(process);
+    }
+}
+
+static PCB* gang_pick_next(void) {
+    if (placed == 0) {
+        return NULL;
+    }
+    long now = calculate_elapsed_time();
+    bool slot_over = slot_start_ms >= 0 && now - slot_start_ms >= system_state.tunables.gang_slot_ms;
+    
+    // Troca de linha só com a linha atual toda fora da CPU
+    if (row_running == 0 && (slot_over || gang_row_pending() == NULL)) {
+        gang_advance(now);
+    }
+    
+    PCB* process = gang_row_pending();
+    if (process == NULL) {
+        return NULL;
+    }
+    if (slot_start_ms < 0) {
+        slot_start_ms = now;
+    }
+    row_next_col = process->gang_col + 1;
+    row_running++;
+    slot_width += gang_width(process);
+    process->gang_dispatch_ms = now;
+    return process;
+}
+
+/* Fim da fatia: o processo continua na sua linha até a próxima volta */
+static void gang_put_prev(PCB* process) {
+    gang_leave(process);
+}
+
+/**
+ * Todos da linha pedem a CPU de volta no bloco que completa a fatia
+ * O pedido sai no meio desse bloco: perto da fronteira ele correria com as
+ * threads e poderia valer já para o bloco anterior
+ */
+static bool gang_tick(PCB* curr, long now_ms) {
+    (void)curr;
+    return slot_start_ms >= 0 &&
+           now_ms - slot_start_ms + THREAD_EXECUTION_TIME / 2 >= system_state.tunables.gang_slot_ms &&
+           gang_other_rows_waiting();
+}
+
+static bool gang_check_preempt(PCB* curr) {
+    (void)curr;
+    return false;
+}
+
+static bool gang_has_queued(void) {
+    return placed > row_running;
+}
+
+void gang_get_stats(GangStats* out) {
+    if (slot_start_ms >= 0 && row_running == 0) {
+        gang_close_slot(last_leave_ms);
+    }
+    *out = stats;
+}
+
+const SchedClass gang_sched_class = {
+    .name = "GANG",
+    .init = gang_init,
+    .exit = gang_exit,
+    .enqueue = gang_enqueue,
+    .dequeue = gang_dequeue,
+    .pick_next = gang_pick_next,
+    .put_prev = gang_put_prev,
+    .tick = gang_tick,
+    .check_preempt = gang_check_preempt,
+    .has_queued = gang_has_queued,
+    .gang = true,
+};
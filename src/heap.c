@@ -0,0 +1,103 @@
+#include "../lib/heap.h"
+#include <stdlib.h>
+
+static void heap_place(ProcessHeap* heap, int index, PCB* pcb) {
+    heap->items[index] = pcb;
+    pcb->heap_index = index;
+}
+
+static void heap_sift_up(ProcessHeap* heap, int index) {
+    PCB* pcb = heap->items[index];
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!heap->less(pcb, heap->items[parent])) {
+            break;
+        }
+        heap_place(heap, index, heap->items[parent]);
+        index = parent;
+    }
+    heap_place(heap, index, pcb);
+}
+
+static void heap_sift_down(ProcessHeap* heap, int index) {
+    PCB* pcb = heap->items[index];
+    for (;;) {
+        int child = 2 * index + 1;
+        if (child >= heap->size) {
+            break;
+        }
+        if (child + 1 < heap->size && heap->less(heap->items[child + 1], heap->items[child])) {
+            child++;
+        }
+        if (!heap->less(heap->items[child], pcb)) {
+            break;
+        }
+        heap_place(heap, index, heap->items[child]);
+        index = child;
+    }
+    heap_place(heap, index, pcb);
+}
+
+int heap_init(ProcessHeap* heap, int capacity, heap_less_func_t less) {
+    if (capacity < 1) capacity = 1;
+    heap->items = malloc(capacity * sizeof(PCB*));
+    heap->size = 0;
+    heap->capacity = heap->items != NULL ? capacity : 0;
+    heap->less = less;
+    return heap->items != NULL;
+}
+
+void heap_destroy(ProcessHeap* heap) {
+    free(heap->items);
+    heap->items = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+}
+
+int heap_push(ProcessHeap* heap, PCB* pcb) {
+    if (heap->size == heap->capacity) {
+        int new_capacity = heap->capacity > 0 ? heap->capacity * 2 : 8;
+        PCB** new_items = realloc(heap->items, new_capacity * sizeof(PCB*));
+        if (new_items == NULL) {
+            return 0;
+        }
+        heap->items = new_items;
+        heap->capacity = new_capacity;
+    }
+    heap_place(heap, heap->size++, pcb);
+    heap_sift_up(heap, pcb->heap_index);
+    return 1;
+}
+
+PCB* heap_peek(const ProcessHeap* heap) {
+    return heap->size > 0 ? heap->items[0] : NULL;
+}
+
+PCB* heap_pop(ProcessHeap* heap) {
+    PCB* top = heap_peek(heap);
+    if (top != NULL) {
+        heap_remove(heap, top);
+    }
+    return top;
+}
+
+int heap_remove(ProcessHeap* heap, PCB* pcb) {
+    int index = pcb->heap_index;
+    if (index < 0 || index >= heap->size || heap->items[index] != pcb) {
+        return 0;
+    }
+    
+    PCB* last = heap->items[--heap->size];
+    pcb->heap_index = -1;
+    if (last != pcb) {
+        // O último ocupa o buraco e desce ou sobe conforme a chave
+        heap_place(heap, index, last);
+        heap_sift_down(heap, index);
+        heap_sift_up(heap, last->heap_index);
+    }
+    return 1;
+}
+
+bool heap_is_empty(const ProcessHeap* heap) {
+    return heap->size == 0;
+}
@@ -0,0 +1,189 @@
+#include "../lib/hotplug.h"
+#include "../lib/scheduler.h"
+#include "../lib/tcb_sched.h"
+#include "../lib/affinity.h"
+#include "../lib/topology.h"
+#include "../lib/smt.h"
+#include "../lib/log.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Hotplug
+ * - Sem filas por CPU, o balanceamento para uma CPU que entra é a própria
+ *   fila da classe: a CPU livre recebe o próximo processo no mesmo ciclo
+ * - CPU que sai: um processo em várias CPUs apenas perde esta; um processo
+ *   só nela migra para uma CPU livre (cobrado como migração) ou, sem
+ *   nenhuma, devolve a CPU no fim do bloco; a CPU fica fora de linha desde
+ *   o evento e não recebe mais ninguém
+ * - Recuperação: até a CPU que entrou executar algo, ou até o processo
+ *   drenado voltar a uma CPU (0 quando migrou ou continuou nas outras)
+ * - O arquivo de comandos é lido a cada HOTPLUG_POLL_MS, do ponto onde parou
+ */
+
+#define HOTPLUG_POLL_MS 100
+#define MAX_HOTPLUG_LOG (MAX_HOTPLUG_EVENTS * 2)
+
+static int next_scheduled;      // Próximo evento agendado
+static long ctl_offset;         // Posição lida do arquivo de comandos
+static long last_poll_ms;       // Última leitura do arquivo (-1 = nenhuma)
+static HotplugEvent events[MAX_HOTPLUG_LOG];
+static PCB* displaced[MAX_HOTPLUG_LOG]; // Processo drenado de cada evento
+static int nr_events;
+
+/* CPU livre para o processo tirado da CPU que sai (-1 = nenhuma) */
+static int migration_target(const PCB* pcb) {
+    for (int cpu = next_idle_cpu(0); cpu >= 0; cpu = next_idle_cpu(cpu + 1)) {
+        if (core_sched_allows(pcb, cpu)) {
+            return cpu;
+        }
+    }
+    return -1;
+}
+
+/* CPUs online ocupadas pelo processo (a CPU que sai o mantém até o fim do bloco) */
+static int online_cpus_of(const PCB* pcb) {
+    return __builtin_popcountll(__atomic_load_n(&pcb->cpu_mask, __ATOMIC_RELAXED) & system_state.online_cpus);
+}
+
+/* Tira a CPU de linha e esvazia o que ela executava */
+static void take_offline(HotplugEvent* event, int index, long now_ms) {
+    int cpu = event->cpu;
+    set_cpu_online(cpu, false);
+    
+    PCB* process = system_state.current_process_array[cpu];
+    if (process == NULL) {
+        event->recovery_ms = 0;
+        return;
+    }
+    event->displaced_pid = process->pid;
+    
+    if (cpus_of_process(process) > 1) {
+        // Continua nas outras CPUs
+        set_cpu_process(cpu, NULL);
+        pthread_mutex_lock(&process->mutex);
+        tcb_unbind_cpu(cpu);
+        pthread_mutex_unlock(&process->mutex);
+        affinity_note_leave(process, cpu, now_ms);
+        topo_note_leave(process, cpu, now_ms);
+        event->recovery_ms = 0;
+        add_log_message("[HOTPLUG] PID %d deixa a CPU %d e continua nas outras\n", process->pid, cpu);
+        return;
+    }
+    
+    int target = migration_target(process);
+    if (target >= 0) {
+        migrate_running_process(process, cpu, target);
+        event->recovery_ms = 0;
+        add_log_message("[HOTPLUG] PID %d migra da CPU %d para a CPU %d\n", process->pid, cpu, target);
+        return;
+    }
+    
+    // Sem CPU livre: a classe recebe o processo de volta quando o bloco termina
+    request_process_preemption(process);
+    event->drained = true;
+    displaced[index] = process;
+    add_log_message("[HOTPLUG] PID %d devolve a CPU %d no fim do bloco (nenhuma CPU livre)\n", process->pid, cpu);
+}
+
+/**
+ * Aplica um evento (CPU fora do intervalo, sem mudança ou última CPU online
+ * são ignorados)
+ */
+static void apply_event(int cpu, bool online, const char* origin) {
+    if (cpu < 0 || cpu >= system_state.num_cpus) {
+        add_log_message("[HOTPLUG] CPU %d inexistente (%s), evento ignorado\n", cpu, origin);
+        return;
+    }
+    if (cpu_is_online(cpu) == online) return;
+    if (!online && online_cpus() == 1) {
+        add_log_message("[HOTPLUG] CPU %d e a ultima online (%s), continua em linha\n", cpu, origin);
+        return;
+    }
+    if (nr_events == MAX_HOTPLUG_LOG) return;
+    
+    long now = calculate_elapsed_time();
+    int index = nr_events++;
+    HotplugEvent* event = &events[index];
+    *event = (HotplugEvent){ .at_ms = now, .cpu = cpu, .online = online, .recovery_ms = -1 };
+    displaced[index] = NULL;
+    
+    if (online) {
+        set_cpu_online(cpu, true);
+    } else {
+        take_offline(event, index, now);
+    }
+    event->online_cpus = online_cpus();
+    add_log_message("[HOTPLUG] CPU %d %s em %ldms (%s): %d CPU(s) online\n",
+                    cpu, online ? "entra" : "sai", now, origin, event->online_cpus);
+}
+
+/* Comandos novos do arquivo hotplug_ctl ("on N" / "off N") */
+static void poll_control_file(long now_ms) {
+    const char* path = system_state.tunables.hotplug_ctl;
+    if (path[0] == '\0' || (last_poll_ms >= 0 && now_ms - last_poll_ms < HOTPLUG_POLL_MS)) return;
+    last_poll_ms = now_ms;
+    
+    FILE* file = fopen(path, "r");
+    if (file == NULL) return;
+    
+    char line[64];
+    fseek(file, ctl_offset, SEEK_SET);
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (strchr(line, '\n') == NULL) break; // Linha ainda sendo escrita
+        ctl_offset = ftell(file);
+        
+        char state[4];
+        int cpu;
+        if (sscanf(line, "%3s %d", state, &cpu) == 2 && (strcmp(state, "on") == 0 || strcmp(state, "off") == 0)) {
+            apply_event(cpu, strcmp(state, "on") == 0, "comando");
+        }
+    }
+    fclose(file);
+}
+
+/* Mede a recuperação dos eventos ainda pendentes */
+static void track_recovery(long now_ms) {
+    for (int index = 0; index < nr_events; index++) {
+        HotplugEvent* event = &events[index];
+        if (event->recovery_ms >= 0) continue;
+        
+        bool recovered;
+        if (event->online) {
+            recovered = system_state.current_process_array[event->cpu] != NULL;
+        } else {
+            pthread_mutex_lock(&displaced[index]->mutex);
+            bool finished = displaced[index]->state == FINISHED;
+            pthread_mutex_unlock(&displaced[index]->mutex);
+            recovered = finished || online_cpus_of(displaced[index]) > 0;
+        }
+        if (recovered) {
+            event->recovery_ms = now_ms - event->at_ms;
+        }
+    }
+}
+
+void hotplug_init(void) {
+    next_scheduled = 0;
+    ctl_offset = 0;
+    last_poll_ms = -1;
+    nr_events = 0;
+}
+
+void hotplug_apply(void) {
+    const SchedTunables* t = &system_state.tunables;
+    if (t->hotplug_count == 0 && t->hotplug_ctl[0] == '\0') return;
+    
+    long now = calculate_elapsed_time();
+    while (next_scheduled < t->hotplug_count && t->hotplug_at_ms[next_scheduled] <= now) {
+        apply_event(t->hotplug_cpu[next_scheduled], t->hotplug_online[next_scheduled], "agendado");
+        next_scheduled++;
+    }
+    poll_control_file(now);
+    track_recovery(now);
+}
+
+const HotplugEvent* hotplug_get_events(int* count) {
+    *count = nr_events;
+    return events;
+}
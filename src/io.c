@@ -0,0 +1,97 @@
+#include "../lib/io.h"
+#include "../lib/queue.h"
+
+/**
+ * Dispositivo de E/S simulado
+ * - Processos com rajadas (io=CPU:IO,...) emitem a E/S quando o trabalho
+ *   executado alcança a rajada e bloqueiam no fim do bloco em andamento
+ * - Fila FIFO; uma requisição em serviço por vez
+ * - O término acorda o processo como uma chegada (volta à classe)
+ * - O laço de despacho amostra a ocupação a cada ciclo para medir quanto
+ *   da E/S foi sobreposta a computação
+ */
+
+static ReadyQueue device_queue;
+static PCB* in_service;         // Processo sendo atendido (NULL = ocioso)
+static long service_start_ms;
+static long service_end_ms;
+static long last_account_ms;    // Última amostragem (-1 = nenhuma)
+static IOStats stats;
+
+/* Inicia o atendimento do próximo da fila */
+static void io_start_next(long now_ms) {
+    in_service = dequeue_process(&device_queue);
+    if (in_service == NULL) {
+        return;
+    }
+    service_start_ms = now_ms;
+    service_end_ms = now_ms + in_service->io_current_ms;
+    stats.queue_ms += now_ms - in_service->io_blocked_since_ms;
+}
+
+void io_init(void) {
+    init_ready_queue(&device_queue);
+    in_service = NULL;
+    last_account_ms = -1;
+    stats = (IOStats){ 0 };
+}
+
+void io_destroy(void) {
+    destroy_ready_queue(&device_queue);
+}
+
+void io_check_burst(PCB* pcb) {
+    if (pcb->io_pending || pcb->io_next >= pcb->io_count || pcb->remaining_time <= 0) {
+        return;
+    }
+    if (pcb->process_len - pcb->remaining_time < pcb->io_at_ms[pcb->io_next]) {
+        return;
+    }
+    pcb->io_current_ms = pcb->io_ms[pcb->io_next];
+    pcb->io_next++;
+    pcb->io_pending = 1;
+    pcb->should_preempt = 1;
+}
+
+void io_submit(PCB* pcb, long now_ms) {
+    pcb->io_blocked_since_ms = now_ms;
+    enqueue_process(&device_queue, pcb);
+    if (in_service == NULL) {
+        io_start_next(now_ms);
+    }
+}
+
+PCB* io_next_completion(long now_ms) {
+    if (in_service == NULL || now_ms < service_end_ms) {
+        return NULL;
+    }
+    PCB* done = in_service;
+    done->io_blocked_ms += now_ms - done->io_blocked_since_ms;
+    done->io_blocked_since_ms = -1;
+    stats.ops++;
+    io_start_next(now_ms);
+    return done;
+}
+
+bool io_busy(void) {
+    return in_service != NULL || !is_queue_empty(&device_queue);
+}
+
+void io_account(long now_ms, int busy_cpus) {
+    if (last_account_ms >= 0) {
+        long interval = now_ms - last_account_ms;
+        stats.elapsed_ms += interval;
+        stats.cpu_busy_ms += interval * busy_cpus;
+        if (in_service != NULL && service_start_ms < now_ms) {
+            stats.busy_ms += interval;
+            if (busy_cpus > 0) {
+                stats.overlap_ms += interval;
+            }
+        }
+    }
+    last_account_ms = now_ms;
+}
+
+void io_get_stats(IOStats* out) {
+    *out = stats;
+}
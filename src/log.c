@@ -178,6 +178,14 @@ void log_quantum_expired(const char* scheduler_name, int pid) {
     add_log_message("[%s] Quantum do processo PID %d expirado\n", scheduler_name, pid);
 }
 
+void log_process_blocked(const char* scheduler_name, int pid, int io_ms) {
+    add_essential_log_message("[%s] Processo PID %d bloqueado em E/S (%dms)\n", scheduler_name, pid, io_ms);
+}
+
+void log_process_io_done(int pid) {
+    add_essential_log_message("[E/S] Processo PID %d concluiu E/S\n", pid);
+}
+
 void log_scheduler_end() {
     add_essential_log_message("Escalonador terminou execução de todos processos\n");
 }
@@ -249,6 +257,28 @@ const char* get_scheduler_name(SchedulerType type) {
             return "PRIORIDADE";
         case CFS:
             return "CFS";
+        case MLFQ:
+            return "MLFQ";
+        case EDF:
+            return "EDF";
+        case SJF:
+            return "SJF";
+        case SRTF:
+            return "SRTF";
+        case STRIDE:
+            return "STRIDE";
+        case LOTTERY:
+            return "LOTTERY";
+        case RT:
+            return "RT";
+        case SLO:
+            return "SLO";
+        case ADAPTIVE:
+            return "ADAPTIVE";
+        case GANG:
+            return "GANG";
+        case BACKFILL:
+            return "BACKFILL";
         default:
             return "DESCONHECIDO"; //erro
     }
@@ -12,6 +12,10 @@
 #include "scheduler.h"
 #include "queue.h"
 #include "log.h"
+#include "config.h"
+#include "metrics.h"
+#include "sched_class.h"
+#include "io.h"
 
 SystemState system_state;
 
@@ -26,8 +30,8 @@ void cleanup_pcb_list(int count);
 
 int main(int argc, char* argv[]) {
     // Verifica argumentos da linha de comando
-    if (argc != 2) {
-        fprintf(stderr, "Uso: %s <arquivo_entrada>\n", argv[0]);
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s <arquivo_entrada> [chave=valor ...]\n", argv[0]);
         return 1;
     }
     
@@ -41,16 +45,35 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    // Opções da linha de comando sobrepõem as do arquivo de entrada
+    PCB* option_scope = NULL;
+    for (int i = 2; i < argc; i++) {
+        if (!apply_config_option(argv[i], &option_scope)) {
+            fprintf(stderr, "Opcao invalida: %s\n", argv[i]);
+            cleanup_system();
+            return 1;
+        }
+    }
+    
     // Log inicial do sistema
     log_system_start();
     
     // Inicializa o escalonador
     int quantum = THREAD_EXECUTION_TIME;
     if (system_state.scheduler_type == ROUND_ROBIN) {
-        quantum = 500; // Quantum para Round Robin (500ms)
+        quantum = system_state.tunables.rr_quantum_ms; // Quantum para Round Robin (padrão 500ms)
     }
     init_scheduler(system_state.scheduler_type, quantum);
     
+    // Controle de admissão da política (ex.: utilização do EDF)
+    const SchedClass* sched_class = sched_class_of(system_state.scheduler_type);
+    if (sched_class != NULL && sched_class->admit != NULL && !sched_class->admit()) {
+        fprintf(stderr, "Conjunto de processos rejeitado pelo controle de admissao (%s)\n", sched_class->name);
+        save_log_to_file("log_execucao_minikernel.txt");
+        cleanup_system();
+        return 1;
+    }
+    
     // Cria a thread geradora de processos
     pthread_t generator_thread;
     if (pthread_create(&generator_thread, NULL, process_generator_thread, NULL) != 0) {
@@ -85,6 +108,7 @@ int main(int argc, char* argv[]) {
     wait_for_all_threads();
     
     save_log_to_file("log_execucao_minikernel.txt");
+    save_metrics_to_file("metricas_minikernel.txt");
     cleanup_system();
     return 0;
 }
@@ -134,7 +158,7 @@ int read_input_file(const char* filename) {
         }
         
         // Lê prioridade (1 = maior, 5 = menor)
-        if (fscanf(file, "%d", &pcb->priority) != 1 || pcb->priority < 1 || pcb->priority > 5) {
+        if (fscanf(file, "%d", &pcb->priority) != 1 || pcb->priority < 1 || pcb->priority > PRIORITY_LEVELS) {
             add_log_message("ERRO: Formato invalido - prioridade do processo %d (deve ser 1-5)\n", pcb->pid);
             cleanup_pcb_list(i);
             fclose(file);
@@ -157,9 +181,86 @@ int read_input_file(const char* filename) {
             return 0;
         }
         
+        // Coluna opcional: deadline relativo na mesma linha do tempo de chegada
+        pcb->rel_deadline_ms = -1;
+        pcb->slo_ms = -1;
+        pcb->slo_boosted = 0;
+        char line_rest[64];
+        if (fgets(line_rest, sizeof(line_rest), file) != NULL) {
+            int deadline;
+            if (sscanf(line_rest, "%d", &deadline) == 1) {
+                if (deadline <= 0) {
+                    add_log_message("ERRO: Formato invalido - deadline do processo %d\n", pcb->pid);
+                    cleanup_pcb_list(i);
+                    fclose(file);
+                    return 0;
+                }
+                pcb->rel_deadline_ms = deadline;
+            }
+        }
+        
         // Inicializa campos dinâmicos do PCB
         pcb->remaining_time = pcb->process_len;
         pcb->state = READY;
+        pcb->should_preempt = 0;
+        pcb->preempt_epoch = 0;
+        pcb->dispatch_seq = 0;
+        pcb->threads_in_block = 0;
+        pcb->mlfq_level = 0;
+        pcb->mlfq_boost_epoch = -1;
+        memset(&pcb->run_node, 0, sizeof(RBNode));
+        memset(&pcb->dl_node, 0, sizeof(RBNode));
+        pcb->heap_index = -1;
+        pcb->adaptive_epoch = 0;
+        pcb->gang_row = -1;
+        pcb->gang_col = -1;
+        pcb->gang_dispatch_ms = -1;
+        pcb->serial_pct = -1;
+        pcb->cpus_held = 1;
+        pcb->cpu_mask = 0;
+        pcb->tcbs = NULL;
+        pcb->siblings_spread = 0;
+        pcb->last_cpu = -1;
+        pcb->migrations = 0;
+        pcb->off_cpu_ms = -1;
+        pcb->on_cpu_ms = 0;
+        pcb->home_node = -1;
+        pcb->trust_group = 0;
+        pcb->smt_speed_pct = 100;
+        pcb->capacity_pct = 100;
+        pcb->overhead_debt_ms = 0;
+        pcb->overhead_ms = 0;
+        pcb->io_count = 0;
+        pcb->io_next = 0;
+        pcb->io_pending = 0;
+        pcb->io_current_ms = 0;
+        pcb->io_blocked_ms = 0;
+        pcb->io_blocked_since_ms = -1;
+        pcb->tickets = -1;
+        pcb->stride = 0;
+        pcb->pass = 0;
+        memset(&pcb->share_node, 0, sizeof(RBNode));
+        pcb->share_dispatch_ms = 0;
+        pcb->share_received_ms = 0;
+        pcb->share_ideal_ms = 0.0;
+        
+        // Controle de banda (ajustável por opções pid=N) e métricas
+        pcb->cgroup_id = 0;
+        pcb->cfs_quota_ms = -1;
+        pcb->cfs_b = NULL;
+        pcb->throttled_next = NULL;
+        pcb->runtime_snapshot = pcb->process_len;
+        pcb->first_run_ms = -1;
+        pcb->finish_ms = -1;
+        pcb->throttle_count = 0;
+        pcb->throttled_ms = 0;
+        pcb->throttle_start_ms = -1;
+        pcb->ready_since_ms = -1;
+        pcb->max_wait_ms = 0;
+        pcb->total_wait_ms = 0;
+        pcb->effective_priority = 0;
+        pcb->rt_policy = RT_POLICY_NORMAL;
+        pcb->rt_priority = 50;
         
         // Inicializa mecanismos de sincronização
         if (pthread_mutex_init(&pcb->mutex, NULL) != 0) {
@@ -191,8 +292,8 @@ int read_input_file(const char* filename) {
     }
     
     // Valida política de escalonamento
-    if (scheduler_type_int < 1 || scheduler_type_int > 4) {
-        add_log_message("ERRO: Politica de escalonamento invalida: %d (deve ser 1=FCFS, 2=RR, 3=PRIORIDADE, 4=CFS)\n", 
+    if (scheduler_type_int < FCFS || scheduler_type_int > BACKFILL) {
+        add_log_message("ERRO: Politica de escalonamento invalida: %d (deve ser 1=FCFS, 2=RR, 3=PRIORIDADE, 4=CFS, 5=MLFQ, 6=EDF, 7=SJF, 8=SRTF, 9=STRIDE, 10=LOTTERY, 11=RT, 12=SLO, 13=ADAPTIVE, 14=GANG, 15=BACKFILL)\n", 
                        scheduler_type_int);
         cleanup_pcb_list(system_state.process_count);
         fclose(file);
@@ -201,6 +302,17 @@ int read_input_file(const char* filename) {
     
     system_state.scheduler_type = (SchedulerType)scheduler_type_int;
     
+    // Opções chave=valor opcionais após a política (ver config.h)
+    char token[128];
+    PCB* option_scope = NULL;
+    while (fscanf(file, "%127s", token) == 1) {
+        if (!apply_config_option(token, &option_scope)) {
+            cleanup_pcb_list(system_state.process_count);
+            fclose(file);
+            return 0;
+        }
+    }
+    
     fclose(file);
     
     return 1;
@@ -218,12 +330,26 @@ int read_input_file(const char* filename) {
 void* process_thread_function(void* arg) {
     TCB* tcb = (TCB*)arg;
     PCB* pcb = tcb->pcb;
+    int ran_seq = -1; // Último despacho em que esta thread executou um bloco
     
     while (1) {
         pthread_mutex_lock(&pcb->mutex);
         
+        // Preempção solicitada: a última thread a concluir seu bloco devolve a CPU
+        // (com E/S emitida, o processo bloqueia em vez de voltar a pronto)
+        if (pcb->state == RUNNING && pcb->should_preempt &&
+            ran_seq == pcb->dispatch_seq && pcb->threads_in_block == 0) {
+            pcb->should_preempt = 0;
+            pcb->state = pcb->io_pending ? BLOCKED : READY;
+            pthread_cond_broadcast(&pcb->cv);
+        }
+        
         // Aguarda sinal do escalonador enquanto estado != RUNNING e != FINISHED
-        while (pcb->state != RUNNING && pcb->state != FINISHED) {
+        // (com preempção pendente, só inicia bloco quem ainda não executou neste despacho;
+        // no despacho por thread, só executa a thread que está em uma CPU)
+        while (pcb->state != FINISHED &&
+               (pcb->state != RUNNING || (pcb->should_preempt && ran_seq == pcb->dispatch_seq) ||
+                (system_state.tcb_sched && tcb->cpu < 0))) {
             pthread_cond_wait(&pcb->cv, &pcb->mutex);
         }
         
@@ -237,11 +363,15 @@ void* process_thread_function(void* arg) {
         if (pcb->remaining_time <= 0) {
             // Processo já terminou, sinaliza outras threads
             pcb->state = FINISHED;
+            metrics_on_finish(pcb);
             pthread_cond_broadcast(&pcb->cv);
             pthread_mutex_unlock(&pcb->mutex);
             break;
         }
         
+        int block_epoch = pcb->preempt_epoch;
+        ran_seq = pcb->dispatch_seq;
+        pcb->threads_in_block++;
         pthread_mutex_unlock(&pcb->mutex);
         
         // Simula execução por 500ms (conforme especificação)
@@ -249,25 +379,48 @@ void* process_thread_function(void* arg) {
         
         // Decrementa remaining_time de forma segura
         pthread_mutex_lock(&pcb->mutex);
+        pcb->threads_in_block--;
         
-        if (pcb->remaining_time > 0) {
-            pcb->remaining_time -= 500; // Decrementa 500ms
+        // Bloco interrompido por preempção imediata não conta como execução
+        if (pcb->preempt_epoch == block_epoch && pcb->remaining_time > 0) {
+            int work = thread_block_work_ms(pcb, pcb->cpus_held); // 500ms por thread sem amdahl=1
+            int speed_pct = pcb->smt_speed_pct * pcb->capacity_pct / 100;
+            if (speed_pct != 100) {
+                // Núcleo SMT compartilhado (smt_share%) e capacidade das CPUs do processo
+                work = work * speed_pct / 100;
+                if (work < 1) work = 1;
+            }
+            
+            // Sobrecarga de trocas e migrações consome o início dos blocos
+            int overhead = pcb->overhead_debt_ms < work ? pcb->overhead_debt_ms : work;
+            pcb->overhead_debt_ms -= overhead;
+            pcb->overhead_ms += overhead;
+            pcb->remaining_time -= work - overhead;
+            tcb->run_ms += THREAD_EXECUTION_TIME;
             
             
             if (pcb->remaining_time <= 0) {
                 pcb->remaining_time = 0;
                 pcb->state = FINISHED;
+                metrics_on_finish(pcb);
                 pthread_cond_broadcast(&pcb->cv); // Acorda todas as threads do processo
                 
                 pthread_mutex_unlock(&pcb->mutex);
                 break;
             }
+            io_check_burst(pcb);
+        }
+        
+        // Despacho por thread: devolução da CPU pedida pelo escalonador
+        if (tcb->release) {
+            tcb->release = 0;
+            tcb->cpu = -1;
+            tcb->releases++;
         }
         
         pthread_mutex_unlock(&pcb->mutex);
     }
     
-    free(tcb); // Libera a estrutura TCB
     return NULL;
 }
 
@@ -283,34 +436,35 @@ int create_process_threads(PCB* pcb) {
         return 0;
     }
     
+    // TCBs ficam no processo: o despacho por thread e as métricas os consultam
+    pcb->tcbs = calloc(pcb->num_threads, sizeof(TCB));
+    if (pcb->tcbs == NULL) {
+        add_log_message("ERRO: Falha ao alocar TCBs do processo PID %d\n", pcb->pid);
+        free(pcb->thread_ids);
+        pcb->thread_ids = NULL;
+        return 0;
+    }
+    
     // Cria cada thread do processo
     for (int i = 0; i < pcb->num_threads; i++) {
-        // Aloca e inicializa TCB para a thread
-        TCB* tcb = malloc(sizeof(TCB));
-        if (tcb == NULL) {
-            add_log_message("ERRO: Falha ao alocar TCB para thread %d do processo PID %d\n", i, pcb->pid);
-            // Limpa threads já criadas
-            for (int j = 0; j < i; j++) {
-                pthread_cancel(pcb->thread_ids[j]);
-            }
-            free(pcb->thread_ids);
-            pcb->thread_ids = NULL;
-            return 0;
-        }
-        
+        // Inicializa TCB para a thread
+        TCB* tcb = &pcb->tcbs[i];
         tcb->pcb = pcb;
         tcb->thread_index = i;
+        tcb->cpu = -1;
+        tcb->last_cpu = -1;
         
         // Cria a thread
         if (pthread_create(&pcb->thread_ids[i], NULL, process_thread_function, tcb) != 0) {
             add_log_message("ERRO: Falha ao criar thread %d do processo PID %d\n", i, pcb->pid);
-            free(tcb);
             // Limpa threads já criadas
             for (int j = 0; j < i; j++) {
                 pthread_cancel(pcb->thread_ids[j]);
             }
             free(pcb->thread_ids);
             pcb->thread_ids = NULL;
+            free(pcb->tcbs);
+            pcb->tcbs = NULL;
             return 0;
         }
     }
@@ -357,15 +511,8 @@ void* process_generator_thread(void* arg) {
                     if (create_process_threads(pcb)) {
                         log_process_created(pcb->pid, pcb->num_threads);
                         
-                        // Adiciona o processo à estrutura de dados apropriada
-                        if (system_state.scheduler_type == CFS) {
-                            // CFS implementado usando fila FCFS (funcional)
-                            // TODO: Implementar Red-Black Tree completa futuramente  
-                            enqueue_process(&system_state.ready_queue, pcb);
-                        } else {
-                            // Para outras políticas, usa a fila de prontos
-                            enqueue_process(&system_state.ready_queue, pcb);
-                        }
+                        // Fila de chegadas; drain_arrivals entrega à classe de escalonamento
+                        enqueue_process(&system_state.ready_queue, pcb);
                         
                         // Sinalizar o scheduler que há novo processo
                         pthread_mutex_lock(&system_state.scheduler_mutex);
@@ -398,6 +545,9 @@ void init_system() {
     // Inicializa estruturas globais
     memset(&system_state, 0, sizeof(SystemState));
     
+    // Parâmetros ajustáveis com valores padrão
+    init_default_tunables(&system_state.tunables);
+    
     // Inicializa fila de prontos
     init_ready_queue(&system_state.ready_queue);
     
@@ -412,11 +562,13 @@ void cleanup_system() {
         for (int i = 0; i < system_state.process_count; i++) {
             PCB* pcb = &system_state.pcb_list[i];
             
-            // Libera vetor de IDs das threads
+            // Libera vetor de IDs das threads e os TCBs
             if (pcb->thread_ids != NULL) {
                 free(pcb->thread_ids);
                 pcb->thread_ids = NULL;
             }
+            free(pcb->tcbs);
+            pcb->tcbs = NULL;
             
             // Destruir mutexes e variáveis de condição
             pthread_mutex_destroy(&pcb->mutex);
@@ -464,10 +616,11 @@ void cleanup_pcb_list(int count) {
         pthread_mutex_destroy(&pcb->mutex);
         pthread_cond_destroy(&pcb->cv);
         
-        // Libera vetor de thread IDs
+        // Libera vetor de thread IDs e os TCBs
         if (pcb->thread_ids != NULL) {
             free(pcb->thread_ids);
         }
+        free(pcb->tcbs);
     }
     
     // Libera a lista de PCBs
@@ -0,0 +1,683 @@
+#include "metrics.h"
+#include "scheduler.h"
+#include "log.h"
+#include "cfs.h"
+#include "sched_class.h"
+#include "io.h"
+#include "affinity.h"
+#include "topology.h"
+#include "smt.h"
+#include "capacity.h"
+#include "hotplug.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Contadores globais protegidos por mutex próprio (acessados pelo escalonador e threads)
+static pthread_mutex_t metrics_mutex = PTHREAD_MUTEX_INITIALIZER;
+static long dispatch_count = 0;
+
+void metrics_on_ready(PCB* pcb) {
+    if (pcb == NULL) return;
+    
+    long now = calculate_elapsed_time();
+    pthread_mutex_lock(&metrics_mutex);
+    pcb->ready_since_ms = now;
+    pthread_mutex_unlock(&metrics_mutex);
+}
+
+void metrics_on_dispatch(PCB* pcb) {
+    if (pcb == NULL) return;
+    
+    long now = calculate_elapsed_time();
+    pthread_mutex_lock(&metrics_mutex);
+    if (pcb->first_run_ms < 0) {
+        pcb->first_run_ms = now;
+    }
+    if (pcb->ready_since_ms >= 0) {
+        // Fecha o intervalo de espera (expansões para outra CPU não esperaram)
+        long wait = now - pcb->ready_since_ms;
+        pcb->total_wait_ms += wait;
+        if (wait > pcb->max_wait_ms) {
+            pcb->max_wait_ms = wait;
+        }
+        pcb->ready_since_ms = -1;
+    }
+    dispatch_count++;
+    pthread_mutex_unlock(&metrics_mutex);
+}
+
+void metrics_on_finish(PCB* pcb) {
+    if (pcb == NULL) return;
+    
+    long now = calculate_elapsed_time();
+    pthread_mutex_lock(&metrics_mutex);
+    if (pcb->finish_ms < 0) {
+        pcb->finish_ms = now;
+    }
+    pthread_mutex_unlock(&metrics_mutex);
+}
+
+static int compare_long(const void* a, const void* b) {
+    long x = *(const long*)a;
+    long y = *(const long*)b;
+    return (x > y) - (x < y);
+}
+
+/* Percentil pelo método nearest-rank sobre vetor já ordenado */
+static long percentile(const long* sorted, int count, int pct) {
+    if (count == 0) return 0;
+    int rank = (pct * count + 99) / 100;
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1];
+}
+
+/* Escreve média e cauda (p50/p95/p99) de uma série de tempos */
+static void write_distribution(FILE* file, const char* label, long* values, int count) {
+    long sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += values[i];
+    }
+    qsort(values, count, sizeof(long), compare_long);
+    fprintf(file, "%s: media %.1f ms | p50 %ld ms | p95 %ld ms | p99 %ld ms | max %ld ms\n",
+            label, count ? (double)sum / count : 0.0,
+            percentile(values, count, 50), percentile(values, count, 95),
+            percentile(values, count, 99), count ? values[count - 1] : 0);
+}
+
+/* Estatísticas dos grupos de banda do CFS que chegaram a ser configurados */
+static void write_bandwidth_groups(FILE* file) {
+    for (int group = 1; group <= MAX_CGROUPS; group++) {
+        int quota = system_state.tunables.cgroup_quota_ms[group];
+        if (quota <= 0) continue;
+        
+        int nr_throttled = 0;
+        long throttled_ms = 0;
+        cfs_get_bandwidth_stats(group, &nr_throttled, &throttled_ms);
+        fprintf(file, "Grupo %d: quota %d ms / periodo %d ms | estrangulamentos %d | tempo estrangulado %ld ms\n",
+                group, quota, system_state.tunables.cfs_period_ms, nr_throttled, throttled_ms);
+    }
+}
+
+/**
+ * Cumprimento de deadlines (apenas quando algum processo declarou deadline)
+ * Lateness = término - deadline absoluto (negativo = folga); tardiness = max(0, lateness)
+ */
+static void write_deadlines(FILE* file) {
+    int with_deadline = 0;
+    int misses = 0;
+    long lateness_sum = 0;
+    long lateness_max = 0;
+    long tardiness_sum = 0;
+    long tardiness_max = 0;
+    
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        if (pcb->rel_deadline_ms <= 0 || pcb->finish_ms < 0) continue;
+        
+        if (with_deadline == 0) {
+            fprintf(file, "\nPID  deadline  termino  lateness\n");
+        }
+        long deadline = (long)pcb->start_time + pcb->rel_deadline_ms;
+        long lateness = pcb->finish_ms - deadline;
+        long tardiness = lateness > 0 ? lateness : 0;
+        fprintf(file, "%3d  %8ld  %7ld  %8ld%s\n", pcb->pid, deadline, pcb->finish_ms, lateness,
+                lateness > 0 ? "  (perdido)" : "");
+        
+        if (with_deadline == 0 || lateness > lateness_max) lateness_max = lateness;
+        if (tardiness > tardiness_max) tardiness_max = tardiness;
+        lateness_sum += lateness;
+        tardiness_sum += tardiness;
+        if (lateness > 0) misses++;
+        with_deadline++;
+    }
+    
+    if (with_deadline == 0) return;
+    fprintf(file, "Deadlines perdidos: %d/%d\n", misses, with_deadline);
+    fprintf(file, "Lateness: media %.1f ms | max %ld ms\n", (double)lateness_sum / with_deadline, lateness_max);
+    fprintf(file, "Tardiness: media %.1f ms | max %ld ms\n", (double)tardiness_sum / with_deadline, tardiness_max);
+}
+
+/**
+ * Limite ótimo de referência: SRTF ideal (preempção contínua, sem overhead)
+ * simulado sobre as mesmas chegadas e durações, com num_cpus CPUs
+ * Em uma CPU o SRTF minimiza o turnaround médio, então nenhuma política o supera
+ * @return Turnaround médio do SRTF ideal em ms
+ */
+static double srtf_optimal_turnaround(void) {
+    int count = system_state.process_count;
+    long* remaining = malloc(count * sizeof(long));
+    char* running = malloc(count);
+    if (remaining == NULL || running == NULL) {
+        free(remaining);
+        free(running);
+        return 0.0;
+    }
+    for (int i = 0; i < count; i++) {
+        const PCB* pcb = &system_state.pcb_list[i];
+        remaining[i] = process_service_time_ms(pcb, pcb->process_len);
+    }
+    
+    int cpus = system_state.num_cpus > 0 ? system_state.num_cpus : 1;
+    int done = 0;
+    long now = 0;
+    long turnaround_sum = 0;
+    while (done < count) {
+        // Executa os `cpus` processos chegados com menor tempo restante
+        memset(running, 0, count);
+        long next_event = -1;
+        for (int slot = 0; slot < cpus; slot++) {
+            int best = -1;
+            for (int i = 0; i < count; i++) {
+                const PCB* pcb = &system_state.pcb_list[i];
+                if (running[i] || remaining[i] <= 0 || pcb->start_time > now) continue;
+                if (best < 0 || remaining[i] < remaining[best]) best = i;
+            }
+            if (best < 0) break;
+            running[best] = 1;
+            if (next_event < 0 || now + remaining[best] < next_event) next_event = now + remaining[best];
+        }
+        
+        // Próximo evento: término de um processo em execução ou nova chegada
+        for (int i = 0; i < count; i++) {
+            long arrival = system_state.pcb_list[i].start_time;
+            if (remaining[i] > 0 && arrival > now && (next_event < 0 || arrival < next_event)) {
+                next_event = arrival;
+            }
+        }
+        
+        for (int i = 0; i < count; i++) {
+            if (!running[i]) continue;
+            remaining[i] -= next_event - now;
+            if (remaining[i] <= 0) {
+                turnaround_sum += next_event - system_state.pcb_list[i].start_time;
+                done++;
+            }
+        }
+        now = next_event;
+    }
+    
+    free(remaining);
+    free(running);
+    return (double)turnaround_sum / count;
+}
+
+/* Distância do turnaround médio da política ao limite do SRTF ideal */
+static void write_optimal_bound(FILE* file, const long* turnaround, int finished) {
+    if (finished != system_state.process_count) return;
+    
+    long sum = 0;
+    for (int i = 0; i < finished; i++) {
+        sum += turnaround[i];
+    }
+    double mean = (double)sum / finished;
+    double bound = srtf_optimal_turnaround();
+    fprintf(file, "Limite otimo (SRTF ideal): turnaround medio %.1f ms | politica %.1f ms | distancia %+.1f%%\n",
+            bound, mean, bound > 0 ? 100.0 * (mean - bound) / bound : 0.0);
+}
+
+/**
+ * Slowdown limitado: turnaround / max(duração, tau), no mínimo 1
+ * tau evita que jobs muito curtos dominem a média
+ */
+static void write_bounded_slowdown(FILE* file) {
+    long tau = system_state.tunables.bsld_tau_ms;
+    double sum = 0.0;
+    double worst = 0.0;
+    int finished = 0;
+    
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        if (pcb->finish_ms < 0) continue;
+        
+        long service = process_service_time_ms(pcb, pcb->process_len);
+        double slowdown = (double)(pcb->finish_ms - pcb->start_time) / (service > tau ? service : tau);
+        if (slowdown < 1.0) slowdown = 1.0;
+        sum += slowdown;
+        if (slowdown > worst) worst = slowdown;
+        finished++;
+    }
+    
+    if (finished == 0) return;
+    fprintf(file, "Slowdown limitado (tau %ld ms): media %.2f | max %.2f\n", tau, sum / finished, worst);
+}
+
+/* Speedup de Amdahl dos processos com as CPUs que podem ocupar (apenas com amdahl=1) */
+static void write_amdahl_speedup(FILE* file) {
+    if (!system_state.tunables.amdahl || system_state.process_count == 0) return;
+    
+    double sum = 0.0;
+    double best = 0.0;
+    for (int i = 0; i < system_state.process_count; i++) {
+        double speedup = process_speedup(&system_state.pcb_list[i], system_state.num_cpus);
+        sum += speedup;
+        if (speedup > best) best = speedup;
+    }
+    fprintf(file, "Progresso paralelo (Amdahl, fracao serial padrao %d%%): speedup com min(threads, %d) CPU(s): media %.2f | max %.2f\n",
+            system_state.tunables.serial_pct, system_state.num_cpus, sum / system_state.process_count, best);
+}
+
+/**
+ * Sobreposição de CPU e E/S (apenas quando algum processo declarou rajadas)
+ * Sem sobreposição, o makespan seria a computação dividida pelas CPUs mais
+ * toda a E/S em série no dispositivo
+ */
+static void write_io_overlap(FILE* file) {
+    long io_total = 0;
+    long cpu_total = 0;
+    long blocked_total = 0;
+    long first_arrival = -1;
+    long last_finish = 0;
+    int with_io = 0;
+    int finished = 0;
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        if (pcb->io_count > 0) with_io++;
+        for (int burst = 0; burst < pcb->io_next; burst++) {
+            io_total += pcb->io_ms[burst];
+        }
+        cpu_total += process_service_time_ms(pcb, pcb->process_len);
+        blocked_total += pcb->io_blocked_ms;
+        if (first_arrival < 0 || pcb->start_time < first_arrival) first_arrival = pcb->start_time;
+        if (pcb->finish_ms >= 0) {
+            finished++;
+            if (pcb->finish_ms > last_finish) last_finish = pcb->finish_ms;
+        }
+    }
+    if (with_io == 0) return;
+    
+    IOStats io;
+    io_get_stats(&io);
+    long elapsed = io.elapsed_ms > 0 ? io.elapsed_ms : 1;
+    long makespan = last_finish - first_arrival;
+    long serial = cpu_total / system_state.num_cpus + io_total;
+    fprintf(file, "E/S: %d operacoes | dispositivo ocupado %.1f%% | espera media na fila do dispositivo %.1f ms | bloqueado por processo com E/S %.1f ms\n",
+            io.ops, 100.0 * io.busy_ms / elapsed, io.ops > 0 ? (double)io.queue_ms / io.ops : 0.0,
+            (double)blocked_total / with_io);
+    fprintf(file, "Sobreposicao CPU/E/S: %.1f%% da E/S com CPU ocupada | utilizacao das CPUs %.1f%% | vazao %.2f processos/s | makespan %ld ms contra %ld ms sem sobreposicao (%.1f%% recuperado)\n",
+            io.busy_ms > 0 ? 100.0 * io.overlap_ms / io.busy_ms : 0.0,
+            100.0 * io.cpu_busy_ms / ((double)elapsed * system_state.num_cpus),
+            makespan > 0 ? 1000.0 * finished / makespan : 0.0, makespan, serial,
+            serial > 0 ? 100.0 * (serial - makespan) / serial : 0.0);
+}
+
+/* Processos terminados por segundo entre a primeira chegada e o último término */
+static double throughput_per_s(void) {
+    long first_arrival = -1;
+    long last_finish = 0;
+    int finished = 0;
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        if (first_arrival < 0 || pcb->start_time < first_arrival) first_arrival = pcb->start_time;
+        if (pcb->finish_ms >= 0) {
+            finished++;
+            if (pcb->finish_ms > last_finish) last_finish = pcb->finish_ms;
+        }
+    }
+    long makespan = last_finish - first_arrival;
+    return makespan > 0 ? 1000.0 * finished / makespan : 0.0;
+}
+
+/* Sobrecarga de trocas de contexto e migrações (apenas com cs_cost/migration_cost) */
+static void write_switch_overhead(FILE* file) {
+    const SchedTunables* t = &system_state.tunables;
+    if (t->cs_cost_ms == 0 && t->migration_cost_ms == 0) return;
+    
+    long overhead = 0;
+    long useful = 0;
+    int migrations = 0;
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        overhead += pcb->overhead_ms;
+        useful += pcb->process_len - (pcb->remaining_time > 0 ? pcb->remaining_time : 0);
+        migrations += pcb->migrations;
+    }
+    
+    long cpu_time = useful + overhead;
+    fprintf(file, "Sobrecarga de trocas (troca %d ms, migracao %d ms): %ld ms de CPU, %.1f%% do tempo de CPU | %d migracoes | vazao %.2f processos/s\n",
+            t->cs_cost_ms, t->migration_cost_ms, overhead,
+            cpu_time > 0 ? 100.0 * overhead / cpu_time : 0.0, migrations, throughput_per_s());
+}
+
+/* Despachos na CPU quente, migrações e penalidade de cache (com afinidade ou resfriamento) */
+static void write_cache_affinity(FILE* file) {
+    const SchedTunables* t = &system_state.tunables;
+    if (!t->affinity && t->cache_decay_ms == 0) return;
+    
+    long useful = 0;
+    long overhead = 0;
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        useful += pcb->process_len - (pcb->remaining_time > 0 ? pcb->remaining_time : 0);
+        overhead += pcb->overhead_ms;
+    }
+    
+    AffinityStats stats;
+    affinity_get_stats(&stats);
+    long cpu_time = useful + overhead;
+    fprintf(file, "Afinidade de cache (%s, resfriamento %d ms): %d despachos na CPU anterior | %d migracoes | %d esperas pela CPU quente | penalidade de cache %ld ms (%.1f%% do tempo de CPU)\n",
+            t->affinity ? "ligada" : "desligada", t->cache_decay_ms, stats.warm_dispatches, stats.migrations,
+            stats.holds, stats.miss_ms, cpu_time > 0 ? 100.0 * stats.miss_ms / cpu_time : 0.0);
+}
+
+/* Migrações por nível da topologia e tráfego entre nós (apenas com topology=) */
+static void write_topology(FILE* file) {
+    if (topology_cpus() == 0) return;
+    
+    const SchedTunables* t = &system_state.tunables;
+    TopoStats stats;
+    topo_get_stats(&stats);
+    fprintf(file, "Topologia (%d no(s) x %d LLC x %d nucleo(s) x %d SMT): migracoes SMT %d | LLC %d | entre LLCs %d | entre nos %d | %d adiadas pelo intervalo | fora do no de origem %ld ms (%.1f%% do tempo em CPU)\n",
+            t->topo_nodes, t->topo_llcs, t->topo_cores, t->topo_smt,
+            stats.migrations[TOPO_SMT], stats.migrations[TOPO_LLC], stats.migrations[TOPO_NODE],
+            stats.migrations[TOPO_NUMA], stats.deferred, stats.remote_ms,
+            stats.run_ms > 0 ? 100.0 * stats.remote_ms / stats.run_ms : 0.0);
+}
+
+/* Núcleos compartilhados e custo do core scheduling (apenas com smt=1) */
+static void write_smt(FILE* file) {
+    if (smt_width() == 1) return;
+    
+    const SchedTunables* t = &system_state.tunables;
+    SMTStats stats;
+    smt_get_stats(&stats);
+    fprintf(file, "SMT (%d CPU(s) por nucleo, rendimento compartilhado %d%%): %.1f%% do tempo com o nucleo compartilhado | vazao %.2f processos/s",
+            smt_width(), t->smt_share_pct, stats.core_ms > 0 ? 100.0 * stats.shared_ms / stats.core_ms : 0.0,
+            throughput_per_s());
+    if (t->core_sched) {
+        fprintf(file, " | core scheduling: %d recusas, %ld ms de CPU ociosa forcada",
+                stats.refusals, stats.forced_idle_ms);
+    }
+    fprintf(file, "\n");
+}
+
+/**
+ * CPUs heterogêneas (apenas com capacity=): makespan e turnaround médio da
+ * colocação usada; bench/capacity_compare.sh compara com a colocação que
+ * ignora as capacidades
+ */
+static void write_capacity(FILE* file, const long* turnaround, int finished) {
+    if (!capacity_enabled()) return;
+    
+    const SchedTunables* t = &system_state.tunables;
+    char text[MAX_CPUS * 6 + 1];
+    int length = 0;
+    for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+        length += snprintf(text + length, sizeof(text) - length, cpu > 0 ? ",%d" : "%d", capacity_of(cpu));
+    }
+    
+    long first_arrival = -1;
+    long last_finish = 0;
+    long sum = 0;
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        if (first_arrival < 0 || pcb->start_time < first_arrival) first_arrival = pcb->start_time;
+        if (pcb->finish_ms > last_finish) last_finish = pcb->finish_ms;
+    }
+    for (int i = 0; i < finished; i++) {
+        sum += turnaround[i];
+    }
+    
+    CapacityStats stats;
+    capacity_get_stats(&stats);
+    fprintf(file, "Capacidades (%s%%, colocacao %s): makespan %ld ms | turnaround medio %.1f ms | %.1f%% da ocupacao nas CPUs grandes | %d migracoes de pesados\n",
+            text, t->capacity_aware ? "ciente" : "indiferente", last_finish - first_arrival,
+            finished > 0 ? (double)sum / finished : 0.0,
+            stats.busy_ms > 0 ? 100.0 * stats.big_ms / stats.busy_ms : 0.0, stats.misfit_migrations);
+}
+
+/* Tempo de CPU, despachos e migrações de cada thread (apenas no despacho por thread) */
+static void write_thread_stats(FILE* file) {
+    if (!system_state.tcb_sched) return;
+    
+    int dispatches = 0;
+    int migrations = 0;
+    int releases = 0;
+    fprintf(file, "\nPID  thread  cpu_ms  despachos  migracoes  devolucoes\n");
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        if (pcb->tcbs == NULL) continue;
+        
+        for (int index = 0; index < pcb->num_threads; index++) {
+            TCB* tcb = &pcb->tcbs[index];
+            fprintf(file, "%3d  %6d  %6ld  %9d  %9d  %10d\n", pcb->pid, tcb->thread_index, tcb->run_ms,
+                    tcb->dispatches, tcb->migrations, tcb->releases);
+            dispatches += tcb->dispatches;
+            migrations += tcb->migrations;
+            releases += tcb->releases;
+        }
+    }
+    fprintf(file, "Despacho por thread: %d despachos de threads | %d migracoes | %d CPUs devolvidas a fila\n",
+            dispatches, migrations, releases);
+}
+
+/**
+ * Hotplug (apenas com eventos aplicados): recuperação de cada evento e, entre
+ * eventos, a vazão e o turnaround médio dos processos que terminaram no
+ * intervalo, para ver quanto a política demora a voltar ao ritmo
+ */
+static void write_hotplug(FILE* file) {
+    int count;
+    const HotplugEvent* events = hotplug_get_events(&count);
+    if (count == 0) return;
+    
+    fprintf(file, "\nhotplug_ms  cpu  evento  cpus_online  processo  recuperacao_ms\n");
+    long recovery_sum = 0;
+    int recovered = 0;
+    for (int index = 0; index < count; index++) {
+        const HotplugEvent* event = &events[index];
+        char process[24] = "-";
+        if (event->displaced_pid > 0) {
+            snprintf(process, sizeof(process), "%d%s", event->displaced_pid, event->drained ? " (dreno)" : "");
+        }
+        fprintf(file, "%10ld  %3d  %6s  %11d  %8s  %14ld\n", event->at_ms, event->cpu,
+                event->online ? "entra" : "sai", event->online_cpus, process, event->recovery_ms);
+        if (event->recovery_ms >= 0) {
+            recovery_sum += event->recovery_ms;
+            recovered++;
+        }
+    }
+    
+    long first_arrival = -1;
+    long last_finish = 0;
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        if (first_arrival < 0 || pcb->start_time < first_arrival) first_arrival = pcb->start_time;
+        if (pcb->finish_ms > last_finish) last_finish = pcb->finish_ms;
+    }
+    
+    // Intervalos entre eventos: [início, evento 1), [evento 1, evento 2), ..., [último, fim]
+    fprintf(file, "intervalo_ms  cpus_online  terminos  vazao_por_s  turnaround_medio_ms\n");
+    int cpus = events[0].online_cpus + (events[0].online ? -1 : 1);
+    for (int segment = 0; segment <= count; segment++) {
+        long begin = segment == 0 ? first_arrival : events[segment - 1].at_ms;
+        long end = segment == count ? last_finish + 1 : events[segment].at_ms;
+        if (segment > 0) {
+            cpus = events[segment - 1].online_cpus;
+        }
+        if (end <= begin) continue;
+        
+        int finished = 0;
+        long turnaround_sum = 0;
+        for (int i = 0; i < system_state.process_count; i++) {
+            PCB* pcb = &system_state.pcb_list[i];
+            if (pcb->finish_ms >= begin && pcb->finish_ms < end) {
+                finished++;
+                turnaround_sum += pcb->finish_ms - pcb->start_time;
+            }
+        }
+        char range[48];
+        snprintf(range, sizeof(range), "%ld-%ld", begin, end);
+        fprintf(file, "%12s  %11d  %8d  %11.2f  %19.1f\n", range, cpus, finished, 1000.0 * finished / (end - begin),
+                finished > 0 ? (double)turnaround_sum / finished : 0.0);
+    }
+    fprintf(file, "Hotplug: %d evento(s) | recuperacao media %.1f ms | vazao %.2f processos/s\n",
+            count, recovered > 0 ? (double)recovery_sum / recovered : 0.0, throughput_per_s());
+}
+
+/* Taxa de atendimento dos SLOs de latência (apenas quando algum processo declarou SLO) */
+static void write_slo_attainment(FILE* file) {
+    int with_slo = 0;
+    int met = 0;
+    long worst_overshoot = 0;
+    
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        if (pcb->slo_ms <= 0 || pcb->finish_ms < 0) continue;
+        
+        if (with_slo == 0) {
+            fprintf(file, "\nPID  slo  latencia  atendido\n");
+        }
+        long latency = pcb->finish_ms - pcb->start_time;
+        bool attained = latency <= pcb->slo_ms;
+        fprintf(file, "%3d  %3d  %8ld  %s\n", pcb->pid, pcb->slo_ms, latency, attained ? "sim" : "nao");
+        
+        if (attained) met++;
+        if (latency - pcb->slo_ms > worst_overshoot) worst_overshoot = latency - pcb->slo_ms;
+        with_slo++;
+    }
+    
+    if (with_slo == 0) return;
+    fprintf(file, "Atendimento do SLO: %d/%d (%.1f%%) | maior estouro %ld ms\n",
+            met, with_slo, 100.0 * met / with_slo, worst_overshoot);
+}
+
+/**
+ * Fatia proporcional (STRIDE/LOTTERY): tempo de CPU recebido enquanto o processo
+ * estava ativo contra o devido pela fatia ideal dos seus bilhetes
+ */
+static void write_share_error(FILE* file) {
+    if (system_state.scheduler_type != STRIDE && system_state.scheduler_type != LOTTERY) return;
+    
+    fprintf(file, "\nPID  bilhetes  recebido  ideal  erro\n");
+    double abs_error_sum = 0.0;
+    double ideal_sum = 0.0;
+    double max_error_pct = 0.0;
+    for (int i = 0; i < system_state.process_count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        double error = pcb->share_received_ms - pcb->share_ideal_ms;
+        double error_pct = pcb->share_ideal_ms > 0 ? 100.0 * error / pcb->share_ideal_ms : 0.0;
+        fprintf(file, "%3d  %8d  %8ld  %5.0f  %+.1f%%\n", pcb->pid,
+                pcb->tickets > 0 ? pcb->tickets : (6 - pcb->priority) * 100,
+                pcb->share_received_ms, pcb->share_ideal_ms, error_pct);
+        
+        abs_error_sum += error < 0 ? -error : error;
+        ideal_sum += pcb->share_ideal_ms;
+        if (error_pct < 0) error_pct = -error_pct;
+        if (error_pct > max_error_pct) max_error_pct = error_pct;
+    }
+    fprintf(file, "Erro vs fatia ideal: %.1f%% do tempo devido (soma |recebido - ideal| = %.0f ms) | max por processo %.1f%%\n",
+            ideal_sum > 0 ? 100.0 * abs_error_sum / ideal_sum : 0.0, abs_error_sum, max_error_pct);
+}
+
+int save_metrics_to_file(const char* filename) {
+    int count = system_state.process_count;
+    if (system_state.pcb_list == NULL || count <= 0) return 0;
+    
+    FILE* file = fopen(filename, "w");
+    if (file == NULL) {
+        fprintf(stderr, "ERRO: Nao foi possivel criar arquivo de metricas: %s\n", filename);
+        return 0;
+    }
+    
+    long* response = malloc(count * sizeof(long));
+    long* turnaround = malloc(count * sizeof(long));
+    long* max_wait = malloc(count * sizeof(long));
+    if (response == NULL || turnaround == NULL || max_wait == NULL) {
+        free(response);
+        free(turnaround);
+        free(max_wait);
+        fclose(file);
+        return 0;
+    }
+    
+    pthread_mutex_lock(&metrics_mutex);
+    
+    fprintf(file, "=== METRICAS DA SIMULACAO ===\n");
+    fprintf(file, "Politica: %s\n", get_scheduler_name(system_state.scheduler_type));
+    fprintf(file, "PID  chegada  resposta  turnaround  espera_max  estrangulamentos  tempo_estrangulado\n");
+    
+    int finished = 0;
+    long total_throttles = 0;
+    long total_throttled_ms = 0;
+    for (int i = 0; i < count; i++) {
+        PCB* pcb = &system_state.pcb_list[i];
+        long resp = pcb->first_run_ms >= 0 ? pcb->first_run_ms - pcb->start_time : -1;
+        long turn = pcb->finish_ms >= 0 ? pcb->finish_ms - pcb->start_time : -1;
+        
+        fprintf(file, "%3d  %7d  %8ld  %10ld  %10ld  %16d  %18ld\n", pcb->pid, pcb->start_time,
+                resp, turn, pcb->max_wait_ms, pcb->throttle_count, pcb->throttled_ms);
+        
+        if (resp >= 0 && turn >= 0) {
+            response[finished] = resp;
+            turnaround[finished] = turn;
+            max_wait[finished] = pcb->max_wait_ms;
+            finished++;
+        }
+        total_throttles += pcb->throttle_count;
+        total_throttled_ms += pcb->throttled_ms;
+    }
+    
+    fprintf(file, "\nProcessos finalizados: %d/%d\n", finished, count);
+    write_distribution(file, "Tempo de resposta", response, finished);
+    write_distribution(file, "Turnaround", turnaround, finished);
+    write_optimal_bound(file, turnaround, finished);
+    write_bounded_slowdown(file);
+    write_amdahl_speedup(file);
+    write_distribution(file, "Pior espera na fila", max_wait, finished);
+    fprintf(file, "Despachos (trocas de contexto): %ld\n", dispatch_count);
+    fprintf(file, "Estrangulamentos CFS: %ld | tempo estrangulado total: %ld ms\n",
+            total_throttles, total_throttled_ms);
+    write_bandwidth_groups(file);
+    if (system_state.scheduler_type == RT) {
+        int rt_throttles = 0;
+        long rt_throttled_ms = 0;
+        rt_get_throttle_stats(&rt_throttles, &rt_throttled_ms);
+        fprintf(file, "Estrangulamentos do tempo real: %d | tempo estrangulado: %ld ms (banda %d ms / %d ms por CPU)\n",
+                rt_throttles, rt_throttled_ms, system_state.tunables.rt_runtime_ms, system_state.tunables.rt_period_ms);
+    }
+    if (system_state.scheduler_type == ADAPTIVE) {
+        long policy_ms[3];
+        const char* policy_names[3];
+        int switches = adaptive_get_stats(policy_ms, policy_names);
+        fprintf(file, "Trocas de politica (ADAPTIVE): %d | tempo em %s %ld ms, %s %ld ms, %s %ld ms\n", switches,
+                policy_names[0], policy_ms[0], policy_names[1], policy_ms[1], policy_names[2], policy_ms[2]);
+    }
+    if (system_state.scheduler_type == GANG) {
+        GangStats gang;
+        gang_get_stats(&gang);
+        long capacity = gang.capacity_ms > 0 ? gang.capacity_ms : 1;
+        long sync_idle = gang.capacity_ms - gang.busy_ms - gang.fragmented_ms;
+        fprintf(file, "Gang (matriz de Ousterhout): %d fatias, ate %d linhas | utilizacao %.1f%% | ociosidade: fragmentacao %.1f%%, sincronizacao %.1f%%\n",
+                gang.slots, gang.max_rows, 100.0 * gang.busy_ms / capacity,
+                100.0 * gang.fragmented_ms / capacity, 100.0 * (sync_idle > 0 ? sync_idle : 0) / capacity);
+    }
+    if (system_state.scheduler_type == BACKFILL) {
+        int backfilled = 0;
+        long cpu_busy_ms = 0;
+        long span_ms = 0;
+        backfill_get_stats(&backfilled, &cpu_busy_ms, &span_ms);
+        fprintf(file, "Utilizacao das CPUs (BACKFILL%s): %.1f%% | jobs adiantados por backfill: %d\n",
+                system_state.tunables.easy_backfill ? "" : ", FCFS rigido",
+                span_ms > 0 ? 100.0 * cpu_busy_ms / ((double)span_ms * system_state.num_cpus) : 0.0, backfilled);
+    }
+    write_io_overlap(file);
+    write_switch_overhead(file);
+    write_cache_affinity(file);
+    write_topology(file);
+    write_smt(file);
+    write_capacity(file, turnaround, finished);
+    write_hotplug(file);
+    write_deadlines(file);
+    write_slo_attainment(file);
+    write_share_error(file);
+    write_thread_stats(file);
+    
+    pthread_mutex_unlock(&metrics_mutex);
+    
+    free(response);
+    free(turnaround);
+    free(max_wait);
+    fclose(file);
+    return 1;
+}
@@ -0,0 +1,179 @@
+#include "../lib/sched_class.h"
+#include "../lib/scheduler.h"
+#include "../lib/queue.h"
+#include "../lib/log.h"
+
+/**
+ * Multi-Level Feedback Queue
+ * - Um ReadyQueue por nível; o nível 0 tem maior prioridade e o menor quantum
+ * - Processos chegam no nível 0; quem usa o quantum inteiro desce um nível
+ * - Quem volta de E/S mantém o nível (não ganha nível 0 só por bloquear)
+ * - Processo em nível mais alto que chega preempta o atual na fronteira do bloco
+ * - A cada mlfq_boost ms todos voltam ao nível 0 (evita starvation); quem
+ *   estava bloqueado durante o boost volta ao nível 0 ao acordar
+ */
+
+static ReadyQueue levels[MLFQ_MAX_LEVELS];
+static long last_boost_ms;
+static int boost_epoch; // Boosts realizados; o PCB guarda o último que viu
+
+static int mlfq_nr_levels(void) {
+    return system_state.tunables.mlfq_levels;
+}
+
+static int mlfq_quantum(int level) {
+    return system_state.tunables.mlfq_quantum_ms[level];
+}
+
+/* Runtime consumido desde o despacho (soma das threads) */
+static int mlfq_used(PCB* process) {
+    return process->runtime_snapshot - process->remaining_time;
+}
+
+/* Nível mais alto com processos aguardando (-1 = nenhum) */
+static int mlfq_highest_level(void) {
+    for (int level = 0; level < mlfq_nr_levels(); level++) {
+        if (!is_queue_empty(&levels[level])) {
+            return level;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Boost periódico: esvazia os níveis inferiores no nível 0 (preservando a ordem)
+ * e devolve aos processos em execução um quantum novo de nível 0
+ */
+static void mlfq_boost_if_due(long now_ms) {
+    int interval = system_state.tunables.mlfq_boost_ms;
+    if (interval <= 0 || now_ms - last_boost_ms < interval) {
+        return;
+    }
+    last_boost_ms = now_ms;
+    boost_epoch++;
+
+    int moved = 0;
+    for (int level = 1; level < mlfq_nr_levels(); level++) {
+        PCB* process;
+        while ((process = dequeue_process(&levels[level])) != NULL) {
+            process->mlfq_level = 0;
+            process->mlfq_boost_epoch = boost_epoch;
+            enqueue_process(&levels[0], process);
+            moved++;
+        }
+    }
+    for (int processor = 0; processor < system_state.num_cpus; processor++) {
+        PCB* running = system_state.current_process_array[processor];
+        if (running == NULL) {
+            continue;
+        }
+        running->mlfq_boost_epoch = boost_epoch;
+        if (running->mlfq_level > 0) {
+            running->mlfq_level = 0;
+            running->runtime_snapshot = running->remaining_time;
+            moved++;
+        }
+    }
+
+    if (moved > 0) {
+        add_log_message("[MLFQ] Boost: %d processo(s) de volta ao nivel 0\n", moved);
+    }
+}
+
+static void mlfq_init(void) {
+    for (int level = 0; level < MLFQ_MAX_LEVELS; level++) {
+        init_ready_queue(&levels[level]);
+    }
+    last_boost_ms = calculate_elapsed_time();
+    boost_epoch = 0;
+}
+
+static void mlfq_exit(void) {
+    for (int level = 0; level < MLFQ_MAX_LEVELS; level++) {
+        destroy_ready_queue(&levels[level]);
+    }
+}
+
+/* Primeira chegada ou boost perdido enquanto bloqueado: nível 0; senão mantém o nível */
+static void mlfq_enqueue(PCB* process) {
+    if (process->mlfq_boost_epoch != boost_epoch) {
+        process->mlfq_level = 0;
+        process->mlfq_boost_epoch = boost_epoch;
+    }
+    enqueue_process(&levels[process->mlfq_level], process);
+}
+
+static void mlfq_dequeue(PCB* process) {
+    remove_process_from_queue(&levels[process->mlfq_level], process);
+}
+
+static PCB* mlfq_pick_next(void) {
+    mlfq_boost_if_due(calculate_elapsed_time());
+
+    int level = mlfq_highest_level();
+    if (level < 0) {
+        return NULL;
+    }
+    PCB* process = dequeue_process(&levels[level]);
+    if (process != NULL) {
+        // Início do quantum do nível; o nível já reflete os boosts até aqui
+        process->runtime_snapshot = process->remaining_time;
+        process->mlfq_boost_epoch = boost_epoch;
+    }
+    return process;
+}
+
+/* Quem esgotou o quantum desce um nível; quem foi preemptado mantém o nível */
+static void mlfq_put_prev(PCB* process) {
+    int level = process->mlfq_level;
+    if (mlfq_used(process) >= mlfq_quantum(level) && level < mlfq_nr_levels() - 1) {
+        process->mlfq_level = level + 1;
+        add_log_message("[MLFQ] Processo PID %d rebaixado para o nivel %d\n",
+                        process->pid, process->mlfq_level);
+    }
+    enqueue_process(&levels[process->mlfq_level], process);
+}
+
+/* Quantum esgotado quando o bloco em andamento o completa */
+static bool mlfq_tick(PCB* curr, long now_ms) {
+    mlfq_boost_if_due(now_ms);
+    return mlfq_used(curr) + THREAD_EXECUTION_TIME >= mlfq_quantum(curr->mlfq_level);
+}
+
+static bool mlfq_check_preempt(PCB* curr) {
+    int level = mlfq_highest_level();
+    if (level < 0 || level >= curr->mlfq_level) {
+        return false;
+    }
+    add_log_message("[MLFQ] Processo PID %d preemptado por processo do nivel %d\n", curr->pid, level);
+    return true;
+}
+
+static bool mlfq_has_queued(void) {
+    return mlfq_highest_level() >= 0;
+}
+
+static void mlfq_log_dispatch(PCB* process, int cpu) {
+    add_log_message("[MLFQ] Processo PID %d no nivel %d (quantum %dms)\n",
+                    process->pid, process->mlfq_level, mlfq_quantum(process->mlfq_level));
+#ifdef MULTI
+    log_process_start_cpu("MLFQ", process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start("MLFQ", process->pid);
+#endif
+}
+
+const SchedClass mlfq_sched_class = {
+    .name = "MLFQ",
+    .init = mlfq_init,
+    .exit = mlfq_exit,
+    .enqueue = mlfq_enqueue,
+    .dequeue = mlfq_dequeue,
+    .pick_next = mlfq_pick_next,
+    .put_prev = mlfq_put_prev,
+    .tick = mlfq_tick,
+    .check_preempt = mlfq_check_preempt,
+    .has_queued = mlfq_has_queued,
+    .log_dispatch = mlfq_log_dispatch,
+};
@@ -45,6 +45,31 @@ void enqueue_process(ReadyQueue* queue, PCB* pcb) {
     pthread_mutex_unlock(&queue->mutex);
 }
 
+void enqueue_process_front(ReadyQueue* queue, PCB* pcb) {
+    if (queue == NULL || pcb == NULL) return;
+    
+    QueueNode* new_node = malloc(sizeof(QueueNode));
+    if (new_node == NULL) {
+        fprintf(stderr, "Erro: falha ao alocar memória para nó da fila\n");
+        return;
+    }
+    
+    new_node->pcb = pcb;
+    
+    pthread_mutex_lock(&queue->mutex);
+    
+    new_node->next = queue->front;
+    queue->front = new_node;
+    if (queue->rear == NULL) {
+        queue->rear = new_node;
+    }
+    queue->size++;
+    
+    pthread_cond_signal(&queue->cv);
+    
+    pthread_mutex_unlock(&queue->mutex);
+}
+
 PCB* dequeue_process(ReadyQueue* queue) {
     if (queue == NULL) return NULL;
     
@@ -139,6 +164,30 @@ PCB* get_highest_priority_process(ReadyQueue* queue) {
     return highest_priority;
 }
 
+void splice_ready_queue(ReadyQueue* dst, ReadyQueue* src) {
+    if (dst == NULL || src == NULL || dst == src) return;
+    
+    pthread_mutex_lock(&dst->mutex);
+    pthread_mutex_lock(&src->mutex);
+    
+    if (src->front != NULL) {
+        if (dst->rear == NULL) {
+            dst->front = src->front;
+        } else {
+            dst->rear->next = src->front;
+        }
+        dst->rear = src->rear;
+        dst->size += src->size;
+        
+        src->front = NULL;
+        src->rear = NULL;
+        src->size = 0;
+    }
+    
+    pthread_mutex_unlock(&src->mutex);
+    pthread_mutex_unlock(&dst->mutex);
+}
+
 int is_queue_empty(ReadyQueue* queue) {
     if (queue == NULL) return 1;
     
@@ -5,7 +5,6 @@
 
 
 #include "../lib/rbtree.h"
-#include "../lib/structures.h"
 #include <stdlib.h>
 #include <stdio.h>
 
@@ -16,9 +15,33 @@
 #define RB_RIGHT(n)    ((n)->rb_right)
 #define RB_COLOR(n)    ((n)->rb_color)
 
-// Rotações
-static void rb_rotate_left(PCB **root, PCB *x) {
-    PCB *y = x->rb_right;
+// Agregados da subárvore (nós e peso), 0 para subárvore vazia
+static inline int rb_subtree_size(const RBNode *n) {
+    return n ? n->rb_size : 0;
+}
+
+static inline long long rb_subtree_weight_of(const RBNode *n) {
+    return n ? n->rb_subtree_weight : 0;
+}
+
+// Recalcula os agregados de um nó a partir dos filhos
+static inline void rb_augment_recompute(RBNode *n) {
+    n->rb_size = 1 + rb_subtree_size(n->rb_left) + rb_subtree_size(n->rb_right);
+    n->rb_subtree_weight = n->rb_weight + rb_subtree_weight_of(n->rb_left) +
+                           rb_subtree_weight_of(n->rb_right);
+}
+
+// Recalcula agregados do nó até a raiz (após mudança estrutural abaixo dele)
+static void rb_augment_propagate(RBNode *n) {
+    while (n) {
+        rb_augment_recompute(n);
+        n = n->rb_parent;
+    }
+}
+
+// Rotações (o nó que sobe herda os agregados da subárvore; o que desce é recalculado)
+static void rb_rotate_left(RBNode **root, RBNode *x) {
+    RBNode *y = x->rb_right;
     x->rb_right = y->rb_left;
     if (y->rb_left)
         y->rb_left->rb_parent = x;
@@ -31,10 +54,13 @@ static void rb_rotate_left(PCB **root, PCB *x) {
         x->rb_parent->rb_right = y;
     y->rb_left = x;
     x->rb_parent = y;
+    y->rb_size = x->rb_size;
+    y->rb_subtree_weight = x->rb_subtree_weight;
+    rb_augment_recompute(x);
 }
 
-static void rb_rotate_right(PCB **root, PCB *y) {
-    PCB *x = y->rb_left;
+static void rb_rotate_right(RBNode **root, RBNode *y) {
+    RBNode *x = y->rb_left;
     y->rb_left = x->rb_right;
     if (x->rb_right)
         x->rb_right->rb_parent = y;
@@ -47,13 +73,16 @@ static void rb_rotate_right(PCB **root, PCB *y) {
         y->rb_parent->rb_right = x;
     x->rb_right = y;
     y->rb_parent = x;
+    x->rb_size = y->rb_size;
+    x->rb_subtree_weight = y->rb_subtree_weight;
+    rb_augment_recompute(y);
 }
 
 // Fix-up após inserção
-static void rb_insert_fixup(PCB **root, PCB *z) {
+static void rb_insert_fixup(RBNode **root, RBNode *z) {
     while (z->rb_parent && z->rb_parent->rb_color == RB_RED) {
         if (z->rb_parent == z->rb_parent->rb_parent->rb_left) {
-            PCB *y = z->rb_parent->rb_parent->rb_right;
+            RBNode *y = z->rb_parent->rb_parent->rb_right;
             if (y && y->rb_color == RB_RED) {
                 z->rb_parent->rb_color = RB_BLACK;
                 y->rb_color = RB_BLACK;
@@ -69,7 +98,7 @@ static void rb_insert_fixup(PCB **root, PCB *z) {
                 rb_rotate_right(root, z->rb_parent->rb_parent);
             }
         } else {
-            PCB *y = z->rb_parent->rb_parent->rb_left;
+            RBNode *y = z->rb_parent->rb_parent->rb_left;
             if (y && y->rb_color == RB_RED) {
                 z->rb_parent->rb_color = RB_BLACK;
                 y->rb_color = RB_BLACK;
@@ -89,33 +118,39 @@ static void rb_insert_fixup(PCB **root, PCB *z) {
     (*root)->rb_color = RB_BLACK;
 }
 
-void rb_insert(PCB **root, PCB *z, rb_compare_func_t compare) {
+void rb_init(RBRoot *root) {
+    root->rb_node = NULL;
+    root->rb_leftmost = NULL;
+}
+
+void rb_insert_color(RBRoot *root, RBNode *node) {
+    rb_augment_propagate(node->rb_parent);
+    rb_insert_fixup(&root->rb_node, node);
+}
+
+void rb_insert(RBRoot *root, RBNode *z, rb_compare_func_t compare) {
     if (!z || !compare) return;
-    PCB *y = NULL;
-    PCB *x = *root;
-    while (x) {
-        y = x;
-        if (compare(z, x) < 0)
-            x = x->rb_left;
-        else
-            x = x->rb_right;
+    RBNode **link = &root->rb_node;
+    RBNode *parent = NULL;
+    bool is_leftmost = true;
+    while (*link) {
+        parent = *link;
+        if (compare(z, parent) < 0) {
+            link = &parent->rb_left;
+        } else {
+            link = &parent->rb_right;
+            is_leftmost = false;
+        }
     }
-    z->rb_parent = y;
-    if (!y)
-        *root = z;
-    else if (compare(z, y) < 0)
-        y->rb_left = z;
-    else
-        y->rb_right = z;
-    z->rb_left = NULL;
-    z->rb_right = NULL;
-    z->rb_color = RB_RED;
-    rb_insert_fixup(root, z);
+    rb_link_node(z, parent, link);
+    if (is_leftmost)
+        root->rb_leftmost = z;
+    rb_insert_color(root, z);
 }
 
 
 // Substitui u por v na árvore
-static void rb_transplant(PCB **root, PCB *u, PCB *v) {
+static void rb_transplant(RBNode **root, RBNode *u, RBNode *v) {
     if (!u->rb_parent)
         *root = v;
     else if (u == u->rb_parent->rb_left)
@@ -127,17 +162,17 @@ static void rb_transplant(PCB **root, PCB *u, PCB *v) {
 }
 
 // Mínimo da subárvore
-static PCB* rb_minimum(PCB *node) {
+static RBNode* rb_minimum(RBNode *node) {
     while (node->rb_left)
         node = node->rb_left;
     return node;
 }
 
 // Fix-up após remoção
-static void rb_remove_fixup(PCB **root, PCB *x, PCB *x_parent) {
+static void rb_remove_fixup(RBNode **root, RBNode *x, RBNode *x_parent) {
     while ((!x || x->rb_color == RB_BLACK) && x != *root) {
         if (x == x_parent->rb_left) {
-            PCB *w = x_parent->rb_right;
+            RBNode *w = x_parent->rb_right;
             if (w && w->rb_color == RB_RED) {
                 w->rb_color = RB_BLACK;
                 x_parent->rb_color = RB_RED;
@@ -163,7 +198,7 @@ static void rb_remove_fixup(PCB **root, PCB *x, PCB *x_parent) {
                 x = *root;
             }
         } else {
-            PCB *w = x_parent->rb_left;
+            RBNode *w = x_parent->rb_left;
             if (w && w->rb_color == RB_RED) {
                 w->rb_color = RB_BLACK;
                 x_parent->rb_color = RB_RED;
@@ -193,11 +228,14 @@ static void rb_remove_fixup(PCB **root, PCB *x, PCB *x_parent) {
     if (x) x->rb_color = RB_BLACK;
 }
 
-void rb_remove(PCB **root, PCB *z) {
-    if (!z || !*root) return;
-    PCB *y = z;
-    PCB *x = NULL;
-    PCB *x_parent = NULL;
+void rb_remove(RBRoot *tree, RBNode *z) {
+    if (!z || !tree->rb_node) return;
+    RBNode **root = &tree->rb_node;
+    if (tree->rb_leftmost == z)
+        tree->rb_leftmost = rb_next(z);
+    RBNode *y = z;
+    RBNode *x = NULL;
+    RBNode *x_parent = NULL;
     int y_original_color = y->rb_color;
     if (!z->rb_left) {
         x = z->rb_right;
@@ -225,6 +263,8 @@ void rb_remove(PCB **root, PCB *z) {
         if (y->rb_left) y->rb_left->rb_parent = y;
         y->rb_color = z->rb_color;
     }
+    // Agregados mudam do ponto mais baixo alterado até a raiz
+    rb_augment_propagate(x_parent);
     if (y_original_color == RB_BLACK)
         rb_remove_fixup(root, x, x_parent);
     // Limpa ponteiros do nó removido
@@ -232,68 +272,165 @@ void rb_remove(PCB **root, PCB *z) {
 }
 
 /**
- * Encontra o nó mais à esquerda (menor vruntime)
+ * Encontra o nó mais à esquerda (menor chave) - mantido em cache
  */
-PCB* rb_leftmost(PCB* root) {
-    if (!root) return NULL;
+RBNode* rb_leftmost(const RBRoot* root) {
+    return root->rb_leftmost;
+}
+
+/**
+ * Encontra o nó mais à direita (maior chave)
+ */
+RBNode* rb_rightmost(const RBRoot* root) {
+    RBNode* node = root->rb_node;
+    if (!node) return NULL;
     
-    while (root->rb_left) {
-        root = root->rb_left;
+    while (node->rb_right) {
+        node = node->rb_right;
     }
-    return root;
+    return node;
 }
 
 /**
- * Encontra o nó mais à direita (maior vruntime)
+ * Sucessor em ordem: mínimo da subárvore direita ou primeiro ancestral
+ * do qual o nó está à esquerda
  */
-PCB* rb_rightmost(PCB* root) {
-    if (!root) return NULL;
-    
-    while (root->rb_right) {
-        root = root->rb_right;
+RBNode* rb_next(const RBNode* node) {
+    if (node->rb_right) {
+        return rb_minimum(node->rb_right);
     }
-    return root;
+    while (node->rb_parent && node == node->rb_parent->rb_right) {
+        node = node->rb_parent;
+    }
+    return node->rb_parent;
 }
 
 /**
  * Busca nó na árvore
  */
-PCB* rb_search(PCB* root, PCB* target, rb_compare_func_t compare) {
-    while (root) {
-        int cmp = compare(target, root);
+RBNode* rb_search(const RBRoot* root, const RBNode* target, rb_compare_func_t compare) {
+    RBNode* node = root->rb_node;
+    while (node) {
+        int cmp = compare(target, node);
         if (cmp == 0) {
-            return root;
+            return node;
         } else if (cmp < 0) {
-            root = root->rb_left;
+            node = node->rb_left;
         } else {
-            root = root->rb_right;
+            node = node->rb_right;
         }
     }
     return NULL;
 }
 
 /**
- * Conta número de nós na árvore
+ * Conta número de nós na árvore - O(1) pelo agregado da raiz
  */
-int rb_count_nodes(PCB* root) {
-    if (!root) return 0;
-    return 1 + rb_count_nodes(root->rb_left) + rb_count_nodes(root->rb_right);
+int rb_count_nodes(const RBRoot* root) {
+    return rb_subtree_size(root->rb_node);
+}
+
+/**
+ * Soma dos pesos de todos os nós - O(1) pelo agregado da raiz
+ */
+long long rb_total_weight(const RBRoot* root) {
+    return rb_subtree_weight_of(root->rb_node);
+}
+
+/**
+ * Posição em ordem do nó: soma as subárvores esquerdas ao subir até a raiz
+ */
+int rb_rank(const RBNode* node) {
+    int rank = rb_subtree_size(node->rb_left);
+    while (node->rb_parent) {
+        if (node == node->rb_parent->rb_right) {
+            rank += rb_subtree_size(node->rb_parent->rb_left) + 1;
+        }
+        node = node->rb_parent;
+    }
+    return rank;
+}
+
+/**
+ * Conta nós (e soma pesos) menores que a chave descendo uma única vez
+ */
+int rb_count_less(const RBRoot* root, rb_key_less_func_t node_less, const void* key,
+                  long long* weight_less) {
+    int count = 0;
+    long long weight = 0;
+    RBNode* node = root->rb_node;
+    while (node) {
+        if (node_less(node, key)) {
+            count += rb_subtree_size(node->rb_left) + 1;
+            weight += rb_subtree_weight_of(node->rb_left) + node->rb_weight;
+            node = node->rb_right;
+        } else {
+            node = node->rb_left;
+        }
+    }
+    if (weight_less) *weight_less = weight;
+    return count;
+}
+
+/**
+ * k-ésimo menor nó (0-based) guiado pelos tamanhos das subárvores
+ */
+RBNode* rb_select(const RBRoot* root, int k) {
+    RBNode* node = root->rb_node;
+    while (node) {
+        int left = rb_subtree_size(node->rb_left);
+        if (k < left) {
+            node = node->rb_left;
+        } else if (k == left) {
+            return node;
+        } else {
+            k -= left + 1;
+            node = node->rb_right;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Nó cujo intervalo de peso acumulado em ordem contém target
+ */
+RBNode* rb_select_by_weight(const RBRoot* root, long long target) {
+    RBNode* node = root->rb_node;
+    if (target < 0 || target >= rb_subtree_weight_of(node)) return NULL;
+    
+    while (node) {
+        long long left = rb_subtree_weight_of(node->rb_left);
+        if (target < left) {
+            node = node->rb_left;
+        } else if (target < left + node->rb_weight) {
+            return node;
+        } else {
+            target -= left + node->rb_weight;
+            node = node->rb_right;
+        }
+    }
+    return NULL;
 }
 
 /**
  * Verifica se árvore está vazia
  */
-bool rb_is_empty(PCB* root) {
-    return (root == NULL);
+bool rb_is_empty(const RBRoot* root) {
+    return (root->rb_node == NULL);
+}
+
+static void rb_walk_subtree(RBNode* node, rb_visit_func_t visit) {
+    if (!node) return;
+    
+    rb_walk_subtree(node->rb_left, visit);
+    visit(node);
+    rb_walk_subtree(node->rb_right, visit);
 }
 
 /**
  * Percorre árvore em ordem
  */
-void rb_inorder_walk(PCB* root, rb_visit_func_t visit) {
-    if (!root || !visit) return;
-    
-    rb_inorder_walk(root->rb_left, visit);
-    visit(root);
-    rb_inorder_walk(root->rb_right, visit);
+void rb_inorder_walk(const RBRoot* root, rb_visit_func_t visit) {
+    if (!visit) return;
+    rb_walk_subtree(root->rb_node, visit);
 }
@@ -0,0 +1,289 @@
+#include "../lib/sched_class.h"
+#include "../lib/scheduler.h"
+#include "../lib/queue.h"
+#include "../lib/log.h"
+
+/**
+ * Classes de tempo real sobre o CFS (política RT)
+ * - Cada processo escolhe sua classe: SCHED_FIFO, SCHED_RR ou normal (CFS)
+ * - Tempo real tem uma fila por prioridade (1..99, maior = mais urgente) e um
+ *   bitmap das filas ocupadas; pick_next consulta o tempo real primeiro e só
+ *   então a árvore do CFS
+ * - SCHED_FIFO executa até terminar ou ser preemptado por prioridade maior;
+ *   SCHED_RR faz rodízio entre processos da mesma prioridade a cada rt_rr_quantum
+ * - Estrangulamento: a cada rt_period o tempo real pode usar no máximo
+ *   rt_runtime por CPU; o restante fica para o CFS
+ */
+
+#define RT_BITMAP_WORDS ((RT_MAX_PRIO + 63) / 64)
+
+static ReadyQueue rt_queues[RT_MAX_PRIO];
+static unsigned long long rt_bitmap[RT_BITMAP_WORDS];
+
+// Banda do tempo real no período atual (soma das CPUs)
+static long rt_period_start_ms;
+static long rt_time_ms;
+static long last_account_ms;
+static bool rt_throttled;
+static long rt_throttle_start_ms;
+static int rt_nr_throttled;
+static long rt_throttled_time_ms;
+
+static bool is_rt(const PCB* process) {
+    return process->rt_policy != RT_POLICY_NORMAL;
+}
+
+static const char* rt_policy_name(const PCB* process) {
+    return process->rt_policy == RT_POLICY_FIFO ? "SCHED_FIFO" : "SCHED_RR";
+}
+
+/* Runtime consumido desde o despacho (quantum do SCHED_RR) */
+static int rt_used(const PCB* process) {
+    return process->runtime_snapshot - process->remaining_time;
+}
+
+static void rt_mark(int prio) {
+    rt_bitmap[prio / 64] |= 1ULL << (prio % 64);
+}
+
+static void rt_clear_if_empty(int prio) {
+    if (is_queue_empty(&rt_queues[prio])) {
+        rt_bitmap[prio / 64] &= ~(1ULL << (prio % 64));
+    }
+}
+
+/* Maior prioridade de tempo real com processos prontos (-1 = nenhuma) */
+static int rt_highest_prio(void) {
+    for (int word = RT_BITMAP_WORDS - 1; word >= 0; word--) {
+        if (rt_bitmap[word] != 0) {
+            return word * 64 + 63 - __builtin_clzll(rt_bitmap[word]);
+        }
+    }
+    return -1;
+}
+
+/* Tempo real pode executar: há processos prontos e a banda não acabou */
+static int rt_runnable_prio(void) {
+    return rt_throttled ? -1 : rt_highest_prio();
+}
+
+static int rt_cpus_running(void) {
+    int cpus = 0;
+    for (int processor = 0; processor < system_state.num_cpus; processor++) {
+        PCB* running = system_state.current_process_array[processor];
+        if (running != NULL && is_rt(running)) {
+            cpus++;
+        }
+    }
+    return cpus;
+}
+
+static long rt_budget_ms(void) {
+    return (long)system_state.tunables.rt_runtime_ms * system_state.num_cpus;
+}
+
+/**
+ * Cobra o tempo de CPU usado pelo tempo real desde a última chamada e recarrega
+ * a banda no início de cada período
+ */
+static void rt_account(long now_ms) {
+    long delta = now_ms - last_account_ms;
+    if (delta > 0) {
+        rt_time_ms += delta * rt_cpus_running();
+        last_account_ms = now_ms;
+    }
+    
+    int period = system_state.tunables.rt_period_ms;
+    if (now_ms - rt_period_start_ms >= period) {
+        rt_period_start_ms = now_ms - (now_ms - rt_period_start_ms) % period;
+        rt_time_ms = 0;
+        if (rt_throttled) {
+            rt_throttled = false;
+            rt_throttled_time_ms += now_ms - rt_throttle_start_ms;
+            add_log_message("[RT] Banda de tempo real recarregada\n");
+        }
+    }
+}
+
+/**
+ * Estrangula o tempo real se mais um bloco nas CPUs de tempo real
+ * ultrapassaria a banda do período (rt_runtime < 0 = ilimitado)
+ */
+static bool rt_check_throttle(long now_ms) {
+    if (system_state.tunables.rt_runtime_ms < 0) {
+        return false;
+    }
+    // Conta em blocos inteiros: o relógio de parede de cada bloco oscila alguns ms
+    long used_blocks = (rt_time_ms + THREAD_EXECUTION_TIME / 2) / THREAD_EXECUTION_TIME;
+    if (!rt_throttled &&
+        (used_blocks + rt_cpus_running()) * THREAD_EXECUTION_TIME > rt_budget_ms()) {
+        rt_throttled = true;
+        rt_throttle_start_ms = now_ms;
+        rt_nr_throttled++;
+        add_log_message("[RT] Tempo real estrangulado (%ldms usados de %ldms no periodo)\n",
+                        rt_time_ms, rt_budget_ms());
+    }
+    return rt_throttled;
+}
+
+static void rt_init(void) {
+    for (int prio = 0; prio < RT_MAX_PRIO; prio++) {
+        init_ready_queue(&rt_queues[prio]);
+    }
+    for (int word = 0; word < RT_BITMAP_WORDS; word++) {
+        rt_bitmap[word] = 0;
+    }
+    rt_period_start_ms = calculate_elapsed_time();
+    last_account_ms = rt_period_start_ms;
+    rt_time_ms = 0;
+    rt_throttled = false;
+    rt_nr_throttled = 0;
+    rt_throttled_time_ms = 0;
+    cfs_sched_class.init();
+}
+
+static void rt_exit(void) {
+    for (int prio = 0; prio < RT_MAX_PRIO; prio++) {
+        destroy_ready_queue(&rt_queues[prio]);
+    }
+    cfs_sched_class.exit();
+}
+
+static void rt_enqueue(PCB* process) {
+    if (!is_rt(process)) {
+        cfs_sched_class.enqueue(process);
+        return;
+    }
+    enqueue_process(&rt_queues[process->rt_priority], process);
+    rt_mark(process->rt_priority);
+}
+
+static void rt_dequeue(PCB* process) {
+    if (!is_rt(process)) {
+        cfs_sched_class.dequeue(process);
+        return;
+    }
+    remove_process_from_queue(&rt_queues[process->rt_priority], process);
+    rt_clear_if_empty(process->rt_priority);
+}
+
+static PCB* rt_pick_next(void) {
+    long now = calculate_elapsed_time();
+    rt_account(now);
+    
+    int prio = rt_runnable_prio();
+    if (prio < 0) {
+        return cfs_sched_class.pick_next();
+    }
+    PCB* process = dequeue_process(&rt_queues[prio]);
+    rt_clear_if_empty(prio);
+    if (process != NULL) {
+        // Início do quantum do SCHED_RR
+        process->runtime_snapshot = process->remaining_time;
+    }
+    return process;
+}
+
+/* SCHED_RR com quantum esgotado vai para o fim da fila; preemptado mantém a vez */
+static void rt_put_prev(PCB* process) {
+    if (!is_rt(process)) {
+        cfs_sched_class.put_prev(process);
+        return;
+    }
+    
+    if (process->rt_policy == RT_POLICY_RR && rt_used(process) >= system_state.tunables.rt_rr_quantum_ms) {
+        enqueue_process(&rt_queues[process->rt_priority], process);
+    } else {
+        enqueue_process_front(&rt_queues[process->rt_priority], process);
+    }
+    rt_mark(process->rt_priority);
+}
+
+static bool rt_tick(PCB* curr, long now_ms) {
+    rt_account(now_ms);
+    
+    if (!is_rt(curr)) {
+        // Tempo real liberado (recarga) tira o CFS da CPU no fim do bloco
+        return rt_runnable_prio() >= 0 || cfs_sched_class.tick(curr, now_ms);
+    }
+    if (rt_check_throttle(now_ms)) {
+        return true;
+    }
+    if (curr->rt_policy == RT_POLICY_RR) {
+        return rt_used(curr) + THREAD_EXECUTION_TIME >= system_state.tunables.rt_rr_quantum_ms &&
+               !is_queue_empty(&rt_queues[curr->rt_priority]);
+    }
+    return false;
+}
+
+/**
+ * Tempo real de prioridade maior interrompe o bloco em andamento (preempt_now)
+ * Normal contra normal segue o CFS: a troca é pedida para o fim do bloco e o
+ * processo não perde o trabalho já feito só porque a política é RT
+ */
+static bool rt_check_preempt(PCB* curr) {
+    int prio = rt_runnable_prio();
+    int curr_prio = is_rt(curr) ? curr->rt_priority : 0;
+    if (prio > curr_prio) {
+        add_log_message("[RT] Processo PID %d preemptado por tempo real de prioridade %d\n", curr->pid, prio);
+        return true;
+    }
+    if (is_rt(curr)) {
+        return false;
+    }
+    
+    pthread_mutex_lock(&curr->mutex);
+    bool pending = curr->should_preempt;
+    pthread_mutex_unlock(&curr->mutex);
+    if (!pending && cfs_sched_class.check_preempt(curr)) {
+        request_process_preemption(curr);
+    }
+    return false;
+}
+
+static bool rt_has_queued(void) {
+    return rt_highest_prio() >= 0 || cfs_sched_class.has_queued();
+}
+
+static void rt_log_dispatch(PCB* process, int cpu) {
+    if (!is_rt(process)) {
+        cfs_sched_class.log_dispatch(process, cpu);
+        return;
+    }
+    add_log_message("[RT] Processo PID %d %s prioridade %d\n",
+                    process->pid, rt_policy_name(process), process->rt_priority);
+#ifdef MULTI
+    log_process_start_cpu(rt_policy_name(process), process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start(rt_policy_name(process), process->pid);
+#endif
+}
+
+static void rt_log_finish(PCB* process) {
+    log_process_finish(is_rt(process) ? rt_policy_name(process) : "CFS", process->pid);
+}
+
+void rt_get_throttle_stats(int* nr_throttled, long* throttled_ms) {
+    *nr_throttled = rt_nr_throttled;
+    *throttled_ms = rt_throttled_time_ms;
+    if (rt_throttled) {
+        *throttled_ms += calculate_elapsed_time() - rt_throttle_start_ms;
+    }
+}
+
+const SchedClass rt_sched_class = {
+    .name = "RT",
+    .init = rt_init,
+    .exit = rt_exit,
+    .enqueue = rt_enqueue,
+    .dequeue = rt_dequeue,
+    .pick_next = rt_pick_next,
+    .put_prev = rt_put_prev,
+    .tick = rt_tick,
+    .check_preempt = rt_check_preempt,
+    .has_queued = rt_has_queued,
+    .log_dispatch = rt_log_dispatch,
+    .log_finish = rt_log_finish,
+    .preempt_now = true,
+};
@@ -0,0 +1,341 @@
+#include "../lib/sched_class.h"
+#include "../lib/scheduler.h"
+#include "../lib/queue.h"
+#include "../lib/log.h"
+#include "../lib/cfs.h"
+#include <stddef.h>
+
+/**
+ * Classes de escalonamento FCFS, Round Robin, Prioridade Preemptiva e CFS
+ * FCFS e RR compartilham uma fila em lista (apenas uma política fica ativa por
+ * execução); a Prioridade usa um bucket por nível e o CFS delega para a
+ * Red-Black Tree de cfs.c
+ */
+
+// Fila de prontos das políticas baseadas em lista
+static ReadyQueue run_queue;
+
+static void list_init(void) {
+    init_ready_queue(&run_queue);
+}
+
+static void list_exit(void) {
+    destroy_ready_queue(&run_queue);
+}
+
+static void list_enqueue(PCB* process) {
+    enqueue_process(&run_queue, process);
+}
+
+static void list_dequeue(PCB* process) {
+    remove_process_from_queue(&run_queue, process);
+}
+
+static PCB* list_pick_next(void) {
+    return dequeue_process(&run_queue);
+}
+
+static bool list_has_queued(void) {
+    return !is_queue_empty(&run_queue);
+}
+
+static bool no_tick(PCB* curr, long now_ms) {
+    (void)curr;
+    (void)now_ms;
+    return false;
+}
+
+static bool no_preempt(PCB* curr) {
+    (void)curr;
+    return false;
+}
+
+/* ========== FCFS ========== */
+
+// Sem preempção: executa na ordem de chegada até terminar
+const SchedClass fcfs_sched_class = {
+    .name = "FCFS",
+    .init = list_init,
+    .exit = list_exit,
+    .enqueue = list_enqueue,
+    .dequeue = list_dequeue,
+    .pick_next = list_pick_next,
+    .put_prev = list_enqueue,
+    .tick = no_tick,
+    .check_preempt = no_preempt,
+    .has_queued = list_has_queued,
+};
+
+/* ========== Round Robin ========== */
+
+static PCB* rr_pick_next(void) {
+    PCB* process = dequeue_process(&run_queue);
+    if (process != NULL) {
+        // Início do quantum: runtime medido pelo remaining_time consumido
+        process->runtime_snapshot = process->remaining_time;
+    }
+    return process;
+}
+
+/**
+ * Quantum esgotado quando o bloco em andamento o completa
+ * No multiprocessador o rodízio é feito pelo rebalanceamento a cada término
+ * (share_idle_cpus), então o quantum não preempta
+ */
+static bool rr_tick(PCB* curr, long now_ms) {
+    (void)now_ms;
+#ifdef MULTI
+    (void)curr;
+    return false;
+#else
+    int used = curr->runtime_snapshot - curr->remaining_time;
+    return used + THREAD_EXECUTION_TIME >= system_state.quantum;
+#endif
+}
+
+static void rr_log_dispatch(PCB* process, int cpu) {
+#ifdef MULTI
+    log_process_start_rr_cpu(process->pid, system_state.quantum, cpu);
+#else
+    (void)cpu;
+    log_process_start_rr(process->pid, system_state.quantum);
+#endif
+}
+
+const SchedClass rr_sched_class = {
+    .name = "RR",
+    .init = list_init,
+    .exit = list_exit,
+    .enqueue = list_enqueue,
+    .dequeue = list_dequeue,
+    .pick_next = rr_pick_next,
+    .put_prev = list_enqueue,
+    .tick = rr_tick,
+    .check_preempt = no_preempt,
+    .has_queued = list_has_queued,
+    .log_dispatch = rr_log_dispatch,
+    .share_idle_cpus = true,
+};
+
+/* ========== Prioridade Preemptiva ========== */
+
+/**
+ * Um bucket FIFO por prioridade efetiva (índice 0 = prioridade 1)
+ * Envelhecimento por época: a cada priority_aging ms todos os buckets sobem um
+ * nível de uma vez (splice O(1) por bucket), sem percorrer a fila; quem espera
+ * k épocas ganha k níveis de prioridade efetiva
+ */
+static ReadyQueue priority_buckets[PRIORITY_LEVELS];
+static long aging_epoch;        // Última época aplicada
+
+static void priority_age(long now_ms) {
+    int interval = system_state.tunables.priority_aging_ms;
+    if (interval <= 0) {
+        return;
+    }
+    
+    long epoch = now_ms / interval;
+    // Após PRIORITY_LEVELS - 1 promoções todos já estão no bucket 0
+    long pending = epoch - aging_epoch;
+    if (pending > PRIORITY_LEVELS - 1) pending = PRIORITY_LEVELS - 1;
+    aging_epoch = epoch;
+    
+    for (long step = 0; step < pending; step++) {
+        for (int level = 1; level < PRIORITY_LEVELS; level++) {
+            splice_ready_queue(&priority_buckets[level - 1], &priority_buckets[level]);
+        }
+    }
+}
+
+/* Bucket mais urgente com processos (-1 = nenhum) */
+static int priority_highest_bucket(void) {
+    for (int level = 0; level < PRIORITY_LEVELS; level++) {
+        if (!is_queue_empty(&priority_buckets[level])) {
+            return level;
+        }
+    }
+    return -1;
+}
+
+static void priority_init(void) {
+    for (int level = 0; level < PRIORITY_LEVELS; level++) {
+        init_ready_queue(&priority_buckets[level]);
+    }
+    int interval = system_state.tunables.priority_aging_ms;
+    aging_epoch = interval > 0 ? calculate_elapsed_time() / interval : 0;
+}
+
+static void priority_exit(void) {
+    for (int level = 0; level < PRIORITY_LEVELS; level++) {
+        destroy_ready_queue(&priority_buckets[level]);
+    }
+}
+
+/* Entra (ou volta) à fila com a prioridade base; o envelhecimento recomeça */
+static void priority_enqueue(PCB* process) {
+    priority_age(calculate_elapsed_time());
+    enqueue_process(&priority_buckets[process->priority - 1], process);
+}
+
+static void priority_dequeue(PCB* process) {
+    for (int level = 0; level < PRIORITY_LEVELS; level++) {
+        if (remove_process_from_queue(&priority_buckets[level], process)) {
+            return;
+        }
+    }
+}
+
+static PCB* priority_pick_next(void) {
+    priority_age(calculate_elapsed_time());
+    int level = priority_highest_bucket();
+    if (level < 0) {
+        return NULL;
+    }
+    PCB* process = dequeue_process(&priority_buckets[level]);
+    if (process != NULL) {
+        // Mantém a prioridade envelhecida enquanto executa
+        process->effective_priority = level + 1;
+    }
+    return process;
+}
+
+static bool priority_has_queued(void) {
+    return priority_highest_bucket() >= 0;
+}
+
+// Preempta se há processo de maior prioridade efetiva (menor número)
+static bool priority_check_preempt(PCB* curr) {
+    priority_age(calculate_elapsed_time());
+    int level = priority_highest_bucket();
+    if (level < 0 || level + 1 >= curr->effective_priority) {
+        return false;
+    }
+    add_log_message("Processo PID %d preemptado por processo de maior prioridade\n", curr->pid);
+    return true;
+}
+
+static void priority_log_dispatch(PCB* process, int cpu) {
+    if (process->effective_priority < process->priority) {
+        add_log_message("[PRIORITY] Processo PID %d envelhecido: prioridade efetiva %d (base %d)\n",
+                        process->pid, process->effective_priority, process->priority);
+    }
+#ifdef MULTI
+    log_process_start_cpu("PRIORITY", process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start_priority(process->pid, process->priority);
+#endif
+}
+
+static void priority_log_finish(PCB* process) {
+#ifdef MULTI
+    log_process_finish("PRIORITY", process->pid);
+#else
+    log_process_finish_priority(process->pid);
+#endif
+}
+
+const SchedClass priority_sched_class = {
+    .name = "PRIORITY",
+    .init = priority_init,
+    .exit = priority_exit,
+    .enqueue = priority_enqueue,
+    .dequeue = priority_dequeue,
+    .pick_next = priority_pick_next,
+    .put_prev = priority_enqueue,
+    .tick = no_tick,
+    .check_preempt = priority_check_preempt,
+    .has_queued = priority_has_queued,
+    .log_dispatch = priority_log_dispatch,
+    .log_finish = priority_log_finish,
+    .preempt_now = true,
+};
+
+/* ========== CFS ========== */
+
+static PCB* cfs_class_pick_next(void) {
+    // Recarrega quotas vencidas antes de escolher (devolve estrangulados à árvore)
+    cfs_bandwidth_refresh(calculate_elapsed_time());
+    return cfs_pick_next();
+}
+
+static void cfs_class_put_prev(PCB* process) {
+    // Cobra o último bloco executado; se estrangulado, aguarda a recarga fora da árvore
+    cfs_charge_runtime(process, calculate_elapsed_time());
+    cfs_put_prev_process(process, 0);
+}
+
+/**
+ * Cobra vruntime, fatia e quota de banda do processo em execução
+ * A preempção é pedida com antecedência de um bloco, pois as threads só
+ * devolvem a CPU na fronteira do bloco de execução
+ */
+static bool cfs_class_tick(PCB* curr, long now_ms) {
+    cfs_bandwidth_refresh(now_ms);
+    bool throttled = cfs_charge_runtime(curr, now_ms);
+    if (throttled && !curr->should_preempt) {
+        add_log_message("[CFS] Processo PID %d estrangulado (quota esgotada)\n", curr->pid);
+    }
+    return throttled || cfs_slice_expired(curr, THREAD_EXECUTION_TIME);
+}
+
+static bool cfs_class_check_preempt(PCB* curr) {
+    if (!cfs_check_preempt_wakeup(curr)) {
+        return false;
+    }
+    add_log_message("[CFS] Processo PID %d preemptado por wakeup\n", curr->pid);
+    return true;
+}
+
+static void cfs_class_log_dispatch(PCB* process, int cpu) {
+    add_log_message("[CFS] Executando processo PID %d (fatia %dus)\n",
+                    process->pid, cfs_get_timeslice(process));
+#ifdef MULTI
+    log_process_start_cpu("CFS", process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start("CFS", process->pid);
+#endif
+}
+
+const SchedClass cfs_sched_class = {
+    .name = "CFS",
+    .init = cfs_init,
+    .exit = cfs_cleanup,
+    .enqueue = cfs_enqueue_process,
+    .dequeue = cfs_dequeue_process,
+    .pick_next = cfs_class_pick_next,
+    .put_prev = cfs_class_put_prev,
+    .tick = cfs_class_tick,
+    .check_preempt = cfs_class_check_preempt,
+    .has_queued = cfs_has_processes,
+    .log_dispatch = cfs_class_log_dispatch,
+};
+
+/* ========== Registro ========== */
+
+// Indexado por SchedulerType
+static const SchedClass* const sched_classes[] = {
+    [FCFS] = &fcfs_sched_class,
+    [ROUND_ROBIN] = &rr_sched_class,
+    [PRIORITY] = &priority_sched_class,
+    [CFS] = &cfs_sched_class,
+    [MLFQ] = &mlfq_sched_class,
+    [EDF] = &edf_sched_class,
+    [SJF] = &sjf_sched_class,
+    [SRTF] = &srtf_sched_class,
+    [STRIDE] = &stride_sched_class,
+    [LOTTERY] = &lottery_sched_class,
+    [RT] = &rt_sched_class,
+    [SLO] = &slo_sched_class,
+    [ADAPTIVE] = &adaptive_sched_class,
+    [GANG] = &gang_sched_class,
+    [BACKFILL] = &backfill_sched_class,
+};
+
+const SchedClass* sched_class_of(SchedulerType type) {
+    if ((int)type < 0 || (size_t)type >= sizeof(sched_classes) / sizeof(sched_classes[0])) {
+        return NULL;
+    }
+    return sched_classes[type];
+}
@@ -3,7 +3,15 @@
 #include "../lib/scheduler.h"
 #include "../lib/queue.h"
 #include "../lib/log.h"
-#include "../lib/cfs.h"
+#include "../lib/sched_class.h"
+#include "../lib/metrics.h"
+#include "../lib/tcb_sched.h"
+#include "../lib/io.h"
+#include "../lib/affinity.h"
+#include "../lib/topology.h"
+#include "../lib/smt.h"
+#include "../lib/capacity.h"
+#include "../lib/hotplug.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
@@ -31,429 +39,97 @@ void init_scheduler(SchedulerType scheduler_type, int quantum) {
     gettimeofday(&tv, NULL);
     system_state.start_time_ms = tv.tv_sec * 1000 + tv.tv_usec / 1000;
     
+    for (int processor = 0; processor < MAX_CPUS; processor++) {
+        system_state.current_process_array[processor] = NULL;
+    }
 #ifdef MULTI
-    system_state.num_cpus = 2;
-    system_state.current_process_array[0] = NULL;
-    system_state.current_process_array[1] = NULL;
+    system_state.num_cpus = topology_cpus() > 0 ? topology_cpus() : system_state.tunables.cpus;
     pthread_mutex_init(&system_state.cpu2_mutex, NULL);
+#else
+    system_state.num_cpus = 1;
 #endif
-}
-
-/**
- * Thread principal do escalonador (modo monoprocessador)
- * Executa continuamente até que todos os processos terminem,
- * delegando para a política específica (FCFS, Round Robin ou Priority)
- */
-void* scheduler_thread(void* arg) {
-    (void)arg; // Suprime warning de parâmetro não utilizado  
     
-    while (1) {
-        // Verifica se deve terminar
-        if (system_state.generator_done && is_queue_empty(&system_state.ready_queue)) {
-            break;
-        }
-        
-        switch (system_state.scheduler_type) {
-            case FCFS:
-                schedule_fcfs();
-                break;
-            case ROUND_ROBIN:
-                schedule_round_robin();
-                break;
-            case PRIORITY:
-                schedule_priority();
-                break;
-            case CFS:
-                schedule_cfs();
-                break;
-            default:
-                fprintf(stderr, "Erro: tipo de escalonador desconhecido\n");
-                break;
-        }
-        
-        // Pequena pausa
-        usleep(10000); // 10ms
-    }
-    
-    log_scheduler_end();
-    return NULL;
+    // Todas as CPUs online e livres
+    CpuMask all = system_state.num_cpus == 64 ? ~0ULL : CPU_BIT(system_state.num_cpus) - 1;
+    system_state.online_cpus = all;
+    system_state.busy_cpus = 0;
+    system_state.idle_cpus = all;
 }
 
-/**
- * Implementação do algoritmo First Come First Served (FCFS)
- * Processos executam até completar sem preempção, na ordem de chegada.
- * Simples mas pode causar "convoy effect" com processos longos.
- */
-void schedule_fcfs() {
-    const char* scheduler_name = get_scheduler_name(system_state.scheduler_type);
-    int iteration_count = 0;
-    
-    add_log_message("Escalonador FCFS iniciado\n");
-    
-    // Loop principal simplificado: enquanto houver processos prontos ou ainda não criados
-    while (!system_state.generator_done || !is_queue_empty(&system_state.ready_queue)) {
-        
-        iteration_count++;
-        
-        // Timeout de segurança
-        if (iteration_count > 100) {
-            break;
-        }
-        
-        // FCFS: pegar primeiro da fila e executar até terminar
-        if (!is_queue_empty(&system_state.ready_queue)) {
-            PCB* process = dequeue_process(&system_state.ready_queue);
-            if (process != NULL) {
-                // add_log_message("Executando processo PID %d por %dms\n", process->pid, process->process_len);
-                
-                // Registrar eventos no log
-                log_process_start(scheduler_name, process->pid);
-                
-                // Mudar estado para RUNNING e acordar threads do processo
-                configure_process_state(process);
-                
-                // Aguardar termino completo (FCFS não preempta)
-                pthread_mutex_lock(&process->mutex);
-                while (process->state != FINISHED) {
-                    pthread_mutex_unlock(&process->mutex);
-                    usleep(10000); // 10ms de pausa
-                    pthread_mutex_lock(&process->mutex);
-                }
-                pthread_mutex_unlock(&process->mutex);
-                
-                // Registrar finalização no log
-                log_process_finish(scheduler_name, process->pid);
-                // add_log_message("Processo PID %d finalizado\n", process->pid);
-            }
-        }
-        
-        // Pequena pausa para não sobrecarregar CPU
-        usleep(10000); // 10ms
-    }
-    
-    add_log_message("Escalonador FCFS finalizado\n");
+/* Verifica se o processo aparece em uma CPU anterior (já tratado neste ciclo) */
+static bool is_process_on_earlier_cpu(PCB* target_proc, int current_cpu_index) {
+    CpuMask earlier = CPU_BIT(current_cpu_index) - 1;
+    return (__atomic_load_n(&target_proc->cpu_mask, __ATOMIC_RELAXED) & earlier) != 0;
 }
 
-/**
- * Implementação do algoritmo Round Robin
- * Cada processo executa por um quantum fixo de tempo antes de ser preemptado.
- * Garante fairness entre processos, evitando starvation.
- */
-void schedule_round_robin() {
-    const char* scheduler_name = get_scheduler_name(system_state.scheduler_type);
-    int iteration_count = 0;
-    
-    add_log_message("Escalonador Round Robin iniciado (quantum: %dms)\n", system_state.quantum);
-    
-    // Round Robin que implementa quantum corretamente
-    while (!system_state.generator_done || !is_queue_empty(&system_state.ready_queue)) {
-        iteration_count++;
-        
-        if (iteration_count > 100) {
-            break;
-        }
-        
-        if (!is_queue_empty(&system_state.ready_queue)) {
-            PCB* process = dequeue_process(&system_state.ready_queue);
-            if (process != NULL) {
-                // add_log_message("RR: Executando processo PID %d\n", process->pid);
-                
-                // Log específico para RR
-                log_process_start_rr(process->pid, system_state.quantum);
-                
-                // Verificar quanto tempo o processo ainda precisa
-                pthread_mutex_lock(&process->mutex);
-                int remaining_time = process->remaining_time;
-                
-                if (remaining_time <= system_state.quantum) {
-                    // Processo termina neste quantum
-                    process->state = RUNNING;
-                    pthread_cond_broadcast(&process->cv);
-                    pthread_mutex_unlock(&process->mutex);
-                    
-                    // Aguardar o processo terminar
-                    pthread_mutex_lock(&process->mutex);
-                    while (process->state != FINISHED) {
-                        pthread_mutex_unlock(&process->mutex);
-                        usleep(10000); // 10ms
-                        pthread_mutex_lock(&process->mutex);
-                    }
-                    pthread_mutex_unlock(&process->mutex);
-                    
-                    log_process_finish(scheduler_name, process->pid);
-                    // add_log_message("RR: Processo PID %d terminou\n", process->pid);
-                } else {
-                    // Processo usa o quantum mas não termina
-                    process->remaining_time -= system_state.quantum;
-                    pthread_mutex_unlock(&process->mutex);
-                    
-                    // Recolocar na fila para próxima execução
-                    enqueue_process(&system_state.ready_queue, process);
-                    // add_log_message("RR: Processo PID %d usou quantum, restam %dms - recolocado na fila\n", 
-                    //                process->pid, process->remaining_time);
-                }
-            }
-        }
-        
-        usleep(10000); // 10ms
-    }
-    
-    add_log_message("Escalonador Round Robin finalizado\n");
+/* Processos escolhidos pela classe esperando fora dela (CPU quente ou núcleo compatível) */
+static bool has_held_processes(void) {
+    return affinity_has_parked() || core_sched_has_waiting();
 }
 
-/**
- * Implementação do algoritmo de Prioridade Preemptiva
- * Processos com maior prioridade (menor número) executam primeiro.
- * Suporta preempção: processo pode ser interrompido por outro de maior prioridade.
- */
-void schedule_priority() {
-    add_log_message("Escalonador por Prioridade iniciado\n");
-    
-    // Executa até que não há mais processos para gerar ou executar
-    do {
-        // Processa apenas se há processos aguardando execução
-        if (is_queue_empty(&system_state.ready_queue)) {
-            usleep(10000);
-            continue;
-        }
-        
-        // Obtém processo com prioridade mais alta da fila
-        PCB* selected_process = get_highest_priority_process(&system_state.ready_queue);
-        if (selected_process == NULL) {
-            usleep(10000);
-            continue;
-        }
-        
-        // Retira processo da fila de prontos
-        remove_process_from_queue(&system_state.ready_queue, selected_process);
-        
-        // Inicia execução do processo selecionado
-        log_process_start_priority(selected_process->pid, selected_process->priority);
-        configure_process_state(selected_process);
-        
-        // Controla execução com possibilidade de preempção
-        int keep_running = 1;
-        do {
-            // Verifica estado atual do processo
-            pthread_mutex_lock(&selected_process->mutex);
-            int time_left = selected_process->remaining_time;
-            ProcessState current_state = selected_process->state;
-            
-            // Finaliza se processo completou execução
-            if (time_left <= 0 || current_state == FINISHED) {
-                selected_process->state = FINISHED;
-                pthread_mutex_unlock(&selected_process->mutex);
-                log_process_finish_priority(selected_process->pid);
-                keep_running = 0;
-                break;
-            }
-            
-            // Define quantum de execução (máximo 50ms)
-            int time_quantum;
-            if (time_left > 50) {
-                time_quantum = 50;
-            } else {
-                time_quantum = time_left;
-            }
-            selected_process->remaining_time -= time_quantum;
-            pthread_mutex_unlock(&selected_process->mutex);
-            
-            // Executa por um quantum
-            usleep(50000); // 50ms
-            
-            // Avalia necessidade de preempção
-            PCB* next_priority_process = get_highest_priority_process(&system_state.ready_queue);
-            if (next_priority_process != NULL) {
-                // Compara prioridades (menor valor = maior prioridade)
-                if (next_priority_process->priority < selected_process->priority) {
-                    // Preempção necessária
-                    pthread_mutex_lock(&selected_process->mutex);
-                    if (selected_process->state != FINISHED && selected_process->remaining_time > 0) {
-                        selected_process->state = READY;
-                        pthread_mutex_unlock(&selected_process->mutex);
-                        
-                        // Reinsere processo na fila
-                        enqueue_process(&system_state.ready_queue, selected_process);
-                        add_log_message("Processo PID %d preemptado por processo de maior prioridade\n", selected_process->pid);
-                        keep_running = 0;
-                    } else {
-                        pthread_mutex_unlock(&selected_process->mutex);
-                    }
-                }
-            }
-        } while (keep_running);
-        
-        // Breve pausa antes da próxima iteração
-        usleep(10000);
-        
-    } while (!system_state.generator_done || !is_queue_empty(&system_state.ready_queue));
-    
-    add_log_message("Escalonador por Prioridade finalizado\n");
-}
-
-/**
- * Implementação do algoritmo Completely Fair Scheduler (CFS)
- * Utiliza Red-Black Tree para ordenar processos por vruntime (tempo virtual)
- * Garante fairness distribuindo tempo de CPU proporcionalmente ao peso dos processos
- */
-/**
- * Algoritmo CFS (Completely Fair Scheduler)
- * Implementação isolada e sem variáveis globais
- */
-void schedule_cfs() {
-    const char* scheduler_name = get_scheduler_name(system_state.scheduler_type);
-    
-    add_log_message("Escalonador CFS iniciado (implementação isolada)\n");
-    
-    // Inicializa sistema CFS
-    cfs_init();
-    
-    // Move todos os processos da fila ready para o CFS
-    while (!is_queue_empty(&system_state.ready_queue)) {
-        PCB* process = dequeue_process(&system_state.ready_queue);
-        if (process != NULL) {
-            cfs_enqueue_process(process);
-        }
-    }
-    
-    // Loop principal do CFS
-    while (!system_state.generator_done || cfs_has_processes()) {
-        
-        // Adiciona novos processos que chegaram
-        while (!is_queue_empty(&system_state.ready_queue)) {
-            PCB* new_process = dequeue_process(&system_state.ready_queue);
-            if (new_process != NULL) {
-                cfs_enqueue_process(new_process);
-            }
-        }
-        
-        // Seleciona próximo processo (menor vruntime)
-        PCB* selected_process = cfs_pick_next();
-        
-        if (selected_process == NULL) {
-            usleep(10000); // 10ms - aguarda novos processos
-            continue;
-        }
-        
-        // Calcula timeslice baseado no peso do processo
-        int timeslice_us = cfs_get_timeslice(selected_process);
-        
-        add_log_message("[CFS] Executando processo PID %d\n", selected_process->pid);
-        
-        // Registra início da execução
-        log_process_start(scheduler_name, selected_process->pid);
-        
-        // Configura processo para execução
-        configure_process_state(selected_process);
-        
-        // Aguarda o processo executar completamente
-        pthread_mutex_lock(&selected_process->mutex);
-        while (selected_process->state == RUNNING) {
-            pthread_mutex_unlock(&selected_process->mutex);
-            usleep(50000); // 50ms - verifica estado do processo
-            pthread_mutex_lock(&selected_process->mutex);
-        }
-        
-        bool process_finished = (selected_process->state == FINISHED);
-        pthread_mutex_unlock(&selected_process->mutex);
-        
-        // Calcula tempo real executado (aproximado)
-        uint64_t runtime_ns = timeslice_us * 1000; // Converte para nanosegundos
-        
-        if (process_finished) {
-            // Processo terminou - registra no log
-            log_process_finish(scheduler_name, selected_process->pid);
-            add_log_message("[CFS] Processo PID %d finalizado\n", selected_process->pid);
-        } else {
-            // Processo foi preemptado - reinsere no CFS com vruntime atualizado
-            cfs_put_prev_process(selected_process, runtime_ns);
+/* Remove processo (e suas threads, no despacho por thread) de todos os CPUs */
+static void remove_process_from_all_cpus(PCB* target_proc) {
+    long now = calculate_elapsed_time();
+    for (int processor = 0; processor < system_state.num_cpus; processor++) {
+        if (system_state.current_process_array[processor] == target_proc) {
+            set_cpu_process(processor, NULL);
+            tcb_unbind_cpu(processor);
+            affinity_note_leave(target_proc, processor, now);
+            topo_note_leave(target_proc, processor, now);
         }
-        
-        usleep(1000); // 1ms entre contextos
     }
-    
-    // Limpa sistema CFS
-    cfs_cleanup();
-    
-    add_log_message("Escalonador CFS finalizado\n");
 }
 
-void configure_process_state(PCB* pcb) {
-    if (pcb == NULL) return;
-    
-    pthread_mutex_lock(&pcb->mutex);
-    pcb->state = RUNNING;
-    pthread_cond_broadcast(&pcb->cv); // Acorda todas as threads do processo
-    pthread_mutex_unlock(&pcb->mutex);
-}
-
-void halt_process_execution(PCB* pcb) {
-    if (pcb == NULL) return;
-    
-    pthread_mutex_lock(&pcb->mutex);
-    if (pcb->state == RUNNING) {
-        pcb->state = READY;
+/* Registra o despacho de um processo em uma CPU no formato da classe */
+static void log_dispatch(const SchedClass* sched_class, PCB* process, int cpu) {
+    if (sched_class->log_dispatch) {
+        sched_class->log_dispatch(process, cpu);
+        return;
     }
-    pthread_mutex_unlock(&pcb->mutex);
-}
-
-PCB* find_higher_priority_process(int current_priority) {
-    PCB* highest_priority = get_highest_priority_process(&system_state.ready_queue);
-    
-    if (highest_priority != NULL && highest_priority->priority < current_priority) {
-        return highest_priority;
-    }
-    
-    return NULL;
-}
-
-void pause_execution(int milliseconds) {
-    usleep(milliseconds * 1000);
-}
-
-long calculate_elapsed_time() {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    long current_time = tv.tv_sec * 1000 + tv.tv_usec / 1000;
-    return current_time - system_state.start_time_ms;
-}
-
-int verify_all_processes_completed() {
-    for (int i = 0; i < system_state.process_count; i++) {
-        pthread_mutex_lock(&system_state.pcb_list[i].mutex);
-        if (system_state.pcb_list[i].state != FINISHED) {
-            pthread_mutex_unlock(&system_state.pcb_list[i].mutex);
-            return 0;
-        }
-        pthread_mutex_unlock(&system_state.pcb_list[i].mutex);
-    }
-    return 1;
-}
-
-void cleanup_scheduler() {
 #ifdef MULTI
-    pthread_mutex_destroy(&system_state.cpu2_mutex);
+    log_process_start_cpu(sched_class->name, process->pid, cpu);
+#else
+    log_process_start(sched_class->name, process->pid);
 #endif
 }
 
-#ifdef MULTI
-/* Verifica se o processo já foi logado como finalizado */
-static bool is_process_already_logged_as_finished(PCB* target_proc, int current_cpu_index) {
-    for (int idx = 0; idx < current_cpu_index; idx++) {
-        if (system_state.current_process_array[idx] == target_proc) {
-            return true;
-        }
+/* Registra o término de um processo no formato da classe */
+static void log_finish(const SchedClass* sched_class, PCB* process) {
+    if (sched_class->log_finish) {
+        sched_class->log_finish(process);
+    } else {
+        log_process_finish(sched_class->name, process->pid);
     }
-    return false;
 }
 
-/* Remove processo de todos os CPUs */
-static void remove_process_from_all_cpus(PCB* target_proc) {
-    for (int processor = 0; processor < system_state.num_cpus; processor++) {
-        if (system_state.current_process_array[processor] == target_proc) {
-            system_state.current_process_array[processor] = NULL;
-        }
+/**
+ * Entrega à classe os processos que chegaram na fila de prontos e os que
+ * concluíram E/S no dispositivo
+ * @return Número de processos recebidos (chegadas podem provocar preempção)
+ */
+static int drain_arrivals(const SchedClass* sched_class) {
+    int arrivals = 0;
+    PCB* process;
+    while ((process = dequeue_process(&system_state.ready_queue)) != NULL) {
+        metrics_on_ready(process);
+        sched_class->enqueue(process);
+        arrivals++;
     }
+    
+    long now = calculate_elapsed_time();
+    while ((process = io_next_completion(now)) != NULL) {
+        pthread_mutex_lock(&process->mutex);
+        process->state = READY;
+        process->io_pending = 0;
+        process->should_preempt = 0;
+        pthread_mutex_unlock(&process->mutex);
+        
+        log_process_io_done(process->pid);
+        metrics_on_ready(process);
+        sched_class->enqueue(process);
+        arrivals++;
+    }
+    return arrivals;
 }
 
 /* Coleta processos ativos exceto o terminado */
@@ -463,39 +139,34 @@ static int collect_active_processes(PCB* finished_process, PCB* active_processes
         PCB* current_proc = system_state.current_process_array[processor];
         if (current_proc != NULL && current_proc != finished_process) {
             active_processes[active_count++] = current_proc;
-            system_state.current_process_array[processor] = NULL; // Limpar para re-alocar
+            set_cpu_process(processor, NULL); // Limpar para re-alocar
         }
     }
     return active_count;
 }
 
-/* Rebalanceia processos Round Robin após término */
-static void rebalance_round_robin_processes(PCB* active_processes[], int active_count, 
-                                          const char* policy_labels[], char* log_buffer) {
-    if (active_count > 0 && !is_queue_empty(&system_state.ready_queue)) {
+/* Rebalanceia processos em rodízio após término */
+static void rebalance_round_robin_processes(const SchedClass* sched_class,
+                                          PCB* active_processes[], int active_count) {
+    if (active_count > 0 && sched_class->has_queued()) {
         // Re-alocar com log se há fila esperando
         for (int slot = 0; slot < active_count; slot++) {
-            system_state.current_process_array[slot] = active_processes[slot];
-            
-            snprintf(log_buffer, 256, "[%s] Executando processo PID %d com quantum %dms // processador %d", 
-                    policy_labels[system_state.scheduler_type], active_processes[slot]->pid, 
-                    THREAD_EXECUTION_TIME, slot);
-            add_essential_log_message("%s\n", log_buffer);
+            set_cpu_process(slot, active_processes[slot]);
+            log_dispatch(sched_class, active_processes[slot], slot);
         }
     } else if (active_count > 0) {
         // Apenas restaurar sem re-logar se não há fila
         for (int slot = 0; slot < active_count; slot++) {
-            system_state.current_process_array[slot] = active_processes[slot];
+            set_cpu_process(slot, active_processes[slot]);
         }
     }
 }
 
 /* Re-loga processos que continuam em outras políticas */
-static void relog_continuing_processes(PCB* finished_process, 
-                                     const char* policy_labels[], char* log_buffer) {
+static void relog_continuing_processes(const SchedClass* sched_class, PCB* finished_process) {
     bool has_available_cpu = false;
     for (int processor = 0; processor < system_state.num_cpus; processor++) {
-        if (system_state.current_process_array[processor] == NULL) {
+        if (cpu_is_idle(processor)) {
             has_available_cpu = true;
             break;
         }
@@ -505,23 +176,21 @@ static void relog_continuing_processes(PCB* finished_process,
         for (int processor = 0; processor < system_state.num_cpus; processor++) {
             PCB* continuing_proc = system_state.current_process_array[processor];
             if (continuing_proc != NULL && continuing_proc != finished_process) {
-                snprintf(log_buffer, 256, "[%s] Executando processo PID %d // processador %d", 
-                        policy_labels[system_state.scheduler_type], continuing_proc->pid, processor);
-                add_essential_log_message("%s\n", log_buffer);
+                log_dispatch(sched_class, continuing_proc, processor);
             }
         }
     }
 }
 
 /**
- * Gerencia os processos que terminaram execução no sistema multiprocessador
+ * Gerencia os processos que terminaram execução
  * - Detecta processos no estado FINISHED
  * - Evita log duplicado do mesmo processo em múltiplos CPUs
  * - Remove processo de todos os CPUs que estava utilizando
- * - Faz rebalanceamento específico para Round Robin
+ * - Faz rebalanceamento para classes em rodízio entre CPUs
  * - Sinaliza o escalonador para verificar novos processos
  */
-static void handle_finished_processes(const char* policy_labels[], char* log_buffer) {
+static void handle_finished_processes(const SchedClass* sched_class) {
     for (int processor = 0; processor < system_state.num_cpus; processor++) {
         PCB* current_proc = system_state.current_process_array[processor];
         if (current_proc == NULL) continue;
@@ -529,22 +198,24 @@ static void handle_finished_processes(const char* policy_labels[], char* log_buf
         pthread_mutex_lock(&current_proc->mutex);
         if (current_proc->state == FINISHED) {
             // Verificar se já foi logado
-            if (!is_process_already_logged_as_finished(current_proc, processor)) {
-                snprintf(log_buffer, 256, "[%s] Processo PID %d finalizado", 
-                        policy_labels[system_state.scheduler_type], current_proc->pid);
-                add_essential_log_message("%s\n", log_buffer);
+            if (!is_process_on_earlier_cpu(current_proc, processor)) {
+                log_finish(sched_class, current_proc);
             }
             
-            // Remover de todos os CPUs
+            // Remover de todos os CPUs e garantir que não restou na fila da classe
             remove_process_from_all_cpus(current_proc);
+            sched_class->dequeue(current_proc);
             
-            // Rebalanceamento específico por política
-            if (system_state.scheduler_type == ROUND_ROBIN && system_state.num_cpus > 1) {
+            // Rebalanceamento conforme a classe (o despacho por thread, a afinidade e o core
+            // scheduling mantêm cada um na sua CPU; com CPUs fora de linha, as primeiras podem não existir)
+            if (sched_class->share_idle_cpus && system_state.num_cpus > 1 && !system_state.tcb_sched &&
+                !system_state.tunables.affinity && !system_state.tunables.core_sched &&
+                online_cpus() == system_state.num_cpus) {
                 PCB* active_processes[system_state.num_cpus];
                 int active_count = collect_active_processes(current_proc, active_processes);
-                rebalance_round_robin_processes(active_processes, active_count, policy_labels, log_buffer);
+                rebalance_round_robin_processes(sched_class, active_processes, active_count);
             } else {
-                relog_continuing_processes(current_proc, policy_labels, log_buffer);
+                relog_continuing_processes(sched_class, current_proc);
             }
             
             // Sinalizar escalonador
@@ -556,23 +227,89 @@ static void handle_finished_processes(const char* policy_labels[], char* log_buf
     }
 }
 
-/* Conta CPUs usados por um processo */
-static int count_cpus_used_by_process(PCB* target_process) {
-    int count = 0;
+/**
+ * Tick da classe para os processos em execução
+ * - Contabiliza a execução (tick) e pede a CPU de volta ao fim da fatia
+ * - Após chegadas, consulta check_preempt (uma preempção por ciclo)
+ * - Processos que já devolveram a CPU liberam seus slots e voltam à classe
+ */
+static void handle_running_processes(const SchedClass* sched_class, bool woken) {
+    long now = calculate_elapsed_time();
+    
     for (int processor = 0; processor < system_state.num_cpus; processor++) {
-        if (system_state.current_process_array[processor] == target_process) {
-            count++;
+        PCB* current_proc = system_state.current_process_array[processor];
+        if (current_proc == NULL || is_process_on_earlier_cpu(current_proc, processor)) {
+            continue; // Processos em mais de um slot são tratados uma vez
+        }
+        
+        pthread_mutex_lock(&current_proc->mutex);
+        ProcessState state = current_proc->state;
+        bool preempt_pending = current_proc->should_preempt;
+        pthread_mutex_unlock(&current_proc->mutex);
+        
+        if (state == RUNNING) {
+            bool slice_over = sched_class->tick(current_proc, now);
+            // Preempção imediata vale mesmo com uma devolução ao fim do bloco já pedida
+            bool may_preempt = !preempt_pending || sched_class->preempt_now;
+            if (woken && may_preempt && sched_class->check_preempt(current_proc)) {
+                if (sched_class->preempt_now) {
+                    halt_process_execution(current_proc);
+                } else {
+                    request_process_preemption(current_proc);
+                }
+                woken = false;
+            } else if (slice_over && !preempt_pending) {
+                request_process_preemption(current_proc);
+            }
+            
+            pthread_mutex_lock(&current_proc->mutex);
+            state = current_proc->state;
+            pthread_mutex_unlock(&current_proc->mutex);
+        }
+        
+        if (state == READY) {
+            remove_process_from_all_cpus(current_proc);
+            metrics_on_ready(current_proc);
+            sched_class->put_prev(current_proc);
+        } else if (state == BLOCKED) {
+            // Sai da CPU com a contabilização da classe e deixa a estrutura até a E/S terminar
+            remove_process_from_all_cpus(current_proc);
+            sched_class->put_prev(current_proc);
+            sched_class->dequeue(current_proc);
+            log_process_blocked(sched_class->name, current_proc->pid, current_proc->io_current_ms);
+            io_submit(current_proc, now);
         }
     }
-    return count;
 }
 
-/* Expande processo para CPUs livres */
+/* Conta CPUs usados por um processo */
+static int count_cpus_used_by_process(PCB* target_process) {
+    return cpus_of_process(target_process);
+}
+
+/**
+ * Publica em cada processo em execução quantas CPUs ele ocupa (modelo de Amdahl)
+ * As threads leem o valor no fim de cada bloco, sob o mutex do processo
+ */
+static void publish_cpus_held(void) {
+    if (!system_state.tunables.amdahl) return;
+    
+    for (int processor = next_running_process_cpu(0); processor >= 0;
+         processor = next_running_process_cpu(processor + 1)) {
+        PCB* process = system_state.current_process_array[processor];
+        int held = count_cpus_used_by_process(process);
+        pthread_mutex_lock(&process->mutex);
+        process->cpus_held = held;
+        pthread_mutex_unlock(&process->mutex);
+    }
+}
+
+/* Expande processo para CPUs livres (sem juntar grupos de confiança no mesmo núcleo) */
 static bool expand_process_to_free_cpus(PCB* target_process) {
     bool expansion_occurred = false;
-    for (int processor = 0; processor < system_state.num_cpus; processor++) {
-        if (system_state.current_process_array[processor] == NULL) {
-            system_state.current_process_array[processor] = target_process;
+    for (int processor = next_idle_cpu(0); processor >= 0; processor = next_idle_cpu(processor + 1)) {
+        if (core_sched_allows(target_process, processor)) {
+            set_cpu_process(processor, target_process);
             expansion_occurred = true;
         }
     }
@@ -580,28 +317,27 @@ static bool expand_process_to_free_cpus(PCB* target_process) {
 }
 
 /* Loga expansão de processo */
-static void log_process_expansion(PCB* target_process, const char* policy_labels[], char* log_buffer) {
+static void log_process_expansion(const SchedClass* sched_class, PCB* target_process) {
     for (int processor = 0; processor < system_state.num_cpus; processor++) {
         if (system_state.current_process_array[processor] == target_process) {
-            snprintf(log_buffer, 256, "[%s] Executando processo PID %d com quantum %dms // processador %d", 
-                    policy_labels[system_state.scheduler_type], target_process->pid, THREAD_EXECUTION_TIME, processor);
-            add_essential_log_message("%s\n", log_buffer);
+            log_dispatch(sched_class, target_process, processor);
         }
     }
 }
 
 /**
- * Gerencia a expansão de processos em Round Robin no multiprocessador
- * No Round Robin, quando a fila está vazia, processos podem usar múltiplos CPUs
+ * Gerencia a expansão de processos em rodízio entre CPUs
+ * Quando a fila está vazia, processos podem usar múltiplos CPUs
  * para acelerar sua execução. Esta função:
- * - Só funciona para Round Robin com fila vazia
+ * - Só funciona para classes com share_idle_cpus e fila vazia
  * - Encontra processos que podem usar mais CPUs
- * - Expande o processo para CPUs livres disponíveis  
+ * - Expande o processo para CPUs livres disponíveis
  * - Registra a expansão no log essencial
  */
-static void handle_process_expansion(const char* policy_labels[], char* log_buffer) {
-    if (!is_queue_empty(&system_state.ready_queue) || system_state.scheduler_type != ROUND_ROBIN) {
-        return; // Só expande Round Robin quando fila vazia
+static void handle_process_expansion(const SchedClass* sched_class) {
+    if (!sched_class->share_idle_cpus || sched_class->has_queued() || has_held_processes() ||
+        system_state.tcb_sched) {
+        return; // Só expande quando a fila está vazia (no despacho por thread, as irmãs ocupam as CPUs)
     }
     
     for (int processor = 0; processor < system_state.num_cpus; processor++) {
@@ -611,240 +347,462 @@ static void handle_process_expansion(const char* policy_labels[], char* log_buff
         }
         
         int current_cpu_count = count_cpus_used_by_process(expanding_process);
-        if (current_cpu_count < system_state.num_cpus) {
+        if (current_cpu_count < online_cpus()) {
             bool expansion_occurred = expand_process_to_free_cpus(expanding_process);
             if (expansion_occurred) {
-                log_process_expansion(expanding_process, policy_labels, log_buffer);
+                log_process_expansion(sched_class, expanding_process);
             }
         }
         break; // Só processar um processo por vez
     }
 }
 
-/**
- * Seleciona próximo processo da fila de prontos baseado na política ativa
- * Implementa lógica de seleção para as três políticas suportadas:
- * - FCFS: Remove primeiro processo da fila (ordem de chegada)
- * - PRIORITY: Remove processo com maior prioridade da fila
- * - ROUND_ROBIN: Remove primeiro processo da fila (FCFS com quantum)
- * Retorna NULL se não houver processos disponíveis
- */
-static PCB* select_process_by_policy(void) {
-    PCB* selected = NULL;
+/* Configura e loga novo processo em CPU (cobrando a troca e a eventual migração) */
+static void assign_process_to_cpu(const SchedClass* sched_class, PCB* selected_process, int cpu_slot) {
+    set_cpu_process(cpu_slot, selected_process);
+    tcb_bind_first(selected_process, cpu_slot);
     
-    switch (system_state.scheduler_type) {
-        case FCFS:
-            selected = dequeue_process(&system_state.ready_queue);
-            break;
-        case PRIORITY:
-            selected = get_highest_priority_process(&system_state.ready_queue);
-            if (selected != NULL) {
-                remove_process_from_queue(&system_state.ready_queue, selected);
-            }
-            break;
-        case ROUND_ROBIN:
-            selected = dequeue_process(&system_state.ready_queue);
-            break;
-        case CFS:
-            // Primeiro, adiciona novos processos ao CFS se houver
-            while (!is_queue_empty(&system_state.ready_queue)) {
-                PCB* new_process = dequeue_process(&system_state.ready_queue);
-                if (new_process != NULL) {
-                    cfs_enqueue_process(new_process);
-                }
-            }
-            // Agora seleciona o próximo processo do CFS
-            selected = cfs_pick_next();
-            break;
-    }
-    
-    return selected;
-}
-
-/* Configura e loga novo processo em CPU */
-static void assign_process_to_cpu(PCB* selected_process, int cpu_slot, 
-                                const char* policy_labels[], char* log_buffer) {
     pthread_mutex_lock(&selected_process->mutex);
-    selected_process->state = RUNNING;
-    system_state.current_process_array[cpu_slot] = selected_process;
-    
-    // Log baseado na política
-    if (system_state.scheduler_type == ROUND_ROBIN) {
-        snprintf(log_buffer, 256, "[%s] Executando processo PID %d com quantum %dms // processador %d", 
-                policy_labels[system_state.scheduler_type], selected_process->pid, THREAD_EXECUTION_TIME, cpu_slot);
-    } else {
-        snprintf(log_buffer, 256, "[%s] Executando processo PID %d // processador %d", 
-                policy_labels[system_state.scheduler_type], selected_process->pid, cpu_slot);
-    }
-    add_essential_log_message("%s\n", log_buffer);
-    
-    pthread_cond_broadcast(&selected_process->cv);
+    charge_switch_overhead(selected_process, selected_process->last_cpu, cpu_slot);
+    selected_process->last_cpu = cpu_slot;
+    topo_note_dispatch(selected_process, cpu_slot, calculate_elapsed_time());
     pthread_mutex_unlock(&selected_process->mutex);
+    log_dispatch(sched_class, selected_process, cpu_slot);
+    configure_process_state(selected_process);
 }
 
-/* Tenta expandir processo multi-thread para CPU adicional */
-static void try_multithread_expansion(PCB* selected_process, int starting_cpu, 
-                                    const char* policy_labels[], char* log_buffer) {
-    if (selected_process->num_threads <= 1 || system_state.scheduler_type == ROUND_ROBIN) {
-        return; // Não expande single-thread ou Round Robin
+/**
+ * Tenta expandir processo multi-thread para CPUs adicionais
+ * Um CPU adicional por vez; classes gang ocupam um CPU por thread de uma vez
+ */
+static void try_multithread_expansion(const SchedClass* sched_class, PCB* selected_process, int starting_cpu) {
+    if (selected_process->num_threads <= 1 || sched_class->share_idle_cpus || system_state.tcb_sched) {
+        return; // Não expande single-thread, classes em rodízio nem no despacho por thread
     }
     
-    for (int processor = starting_cpu + 1; processor < system_state.num_cpus; processor++) {
-        if (system_state.current_process_array[processor] == NULL) {
-            system_state.current_process_array[processor] = selected_process;
-            
-            snprintf(log_buffer, 256, "[%s] Executando processo PID %d // processador %d", 
-                    policy_labels[system_state.scheduler_type], selected_process->pid, processor);
-            add_essential_log_message("%s\n", log_buffer);
-            break; // Só um CPU adicional por vez
+    int extra_cpus = sched_class->gang ? selected_process->num_threads - 1 : 1;
+    for (int processor = starting_cpu + 1; processor < system_state.num_cpus && extra_cpus > 0; processor++) {
+        bool allowed = sched_class->gang || core_sched_allows(selected_process, processor);
+        if (cpu_is_idle(processor) && allowed) {
+            set_cpu_process(processor, selected_process);
+            log_dispatch(sched_class, selected_process, processor);
+            extra_cpus--;
         }
     }
 }
 
 /**
- * Aloca novos processos da fila de prontos para CPUs livres
+ * Aloca processos da classe para CPUs livres
  * Percorre todos os CPUs e para cada um livre:
- * - Seleciona processo baseado na política (FCFS, Priority, Round Robin)
+ * - Com afinidade, despacha antes quem esperava por essa CPU (ou desistiu da sua)
+ * - Com core scheduling, despacha antes quem foi recusado e cabe nessa CPU
+ * - Seleciona o próximo processo pela classe (pick_next)
+ * - Com afinidade, escolhe a CPU quente ou deixa o processo esperando por ela
+ * - Com capacity_aware, leva pesados à maior CPU livre e leves à menor
+ * - Com core scheduling, recusa CPUs cujo núcleo executa outro grupo
  * - Configura processo no CPU e gera log apropriado
- * - Para processos multi-thread (exceto Round Robin), tenta usar CPU adicional
- * Esta é a função principal de alocação no multiprocessador
+ * - Para processos multi-thread, tenta usar CPU adicional
+ * Classes gang ocupam as colunas da matriz/reserva em ordem, sem afinidade
+ * nem core scheduling
  */
-static void allocate_new_processes_to_cpus(const char* policy_labels[], char* log_buffer) {
-    for (int processor = 0; processor < system_state.num_cpus; processor++) {
-        if (system_state.current_process_array[processor] != NULL) {
-            continue; // CPU ocupado
-        }
-
+static void allocate_new_processes_to_cpus(const SchedClass* sched_class) {
+    // Só as CPUs livres, em ordem de índice (a mesma CPU é revisitada quando o processo vai para outra)
+    for (int processor = next_idle_cpu(0); processor >= 0; processor = next_idle_cpu(processor + 1)) {
         PCB* new_process = NULL;
-        int try_count = 0;
-        do {
-            new_process = select_process_by_policy();
-            if (system_state.scheduler_type != CFS || new_process == NULL)
-                break;
-            // Para CFS: só aloque se não está em uso em outro CPU
-            bool already_in_use = false;
-            for (int i = 0; i < system_state.num_cpus; i++) {
-                if (system_state.current_process_array[i] == new_process) {
-                    already_in_use = true;
-                    break;
-                }
-            }
-            if (!already_in_use) {
-                break;
-            } else {
-                // Se já está em uso, devolve para o CFS e tenta pegar outro
-                cfs_put_prev_process(new_process, 0); // 0 ns, só para devolver
-                new_process = NULL;
-            }
-            try_count++;
-        } while (try_count < 10); // Evita loop infinito
-
+        if (!sched_class->gang) {
+            new_process = affinity_take_parked(processor);
+        }
+        if (new_process == NULL && !sched_class->gang) {
+            new_process = core_sched_take_waiting(processor);
+        }
+        if (new_process == NULL) {
+            new_process = sched_class->pick_next();
+        }
         if (new_process == NULL) {
             continue; // Nenhum processo disponível
         }
-
-        assign_process_to_cpu(new_process, processor, policy_labels, log_buffer);
-        try_multithread_expansion(new_process, processor, policy_labels, log_buffer);
+        if (count_cpus_used_by_process(new_process) > 0) {
+            // Já em execução em outro CPU: devolve para a classe
+            sched_class->put_prev(new_process);
+            continue;
+        }
+        
+        int cpu = sched_class->gang ? processor : affinity_select_cpu(new_process, processor);
+        if (cpu < 0) {
+            continue; // Espera a CPU quente; esta fica livre neste ciclo
+        }
+        cpu = sched_class->gang ? cpu : capacity_select_cpu(new_process, cpu);
+        cpu = sched_class->gang ? cpu : core_sched_select_cpu(new_process, cpu);
+        if (cpu < 0) {
+            // Nenhuma CPU livre sem outro grupo no núcleo: espera e a classe oferece o próximo
+            core_sched_hold(new_process);
+            processor--;
+            continue;
+        }
+        assign_process_to_cpu(sched_class, new_process, cpu);
+        try_multithread_expansion(sched_class, new_process, cpu);
+        if (cpu != processor) {
+            processor--; // Foi para a CPU quente: a CPU percorrida continua livre
+        }
     }
 }
 
 /**
- * Executa um ciclo completo de escalonamento multiprocessador
- * Função chamada repetidamente durante o loop principal:
+ * Executa um ciclo completo de escalonamento
+ * - Entrega chegadas à classe
  * - Trata processos que finalizaram (limpeza e remoção das estruturas)
- * - Gerencia expansão de processos multi-thread para CPUs adicionais
- * - Aloca novos processos da fila de prontos para CPUs livres
- * Esta função coordena as três operações fundamentais do escalonador
+ * - Executa o tick da classe (fatias, preempções e devoluções de CPU)
+ * - Tira e põe CPUs em linha (hotplug agendado ou por comando)
+ * - Gerencia expansão de processos para CPUs adicionais
+ * - Aloca novos processos da classe para CPUs livres
+ * - Com capacity_aware, migra pesados de CPUs pequenas para CPUs maiores livres
+ * - No despacho por thread: libera CPUs devolvidas por threads, ocupa as
+ *   livres com threads irmãs e pede uma CPU de volta se há fila
+ * - Publica as CPUs ocupadas por processo (progresso pelo modelo de Amdahl)
+ *   e o rendimento das suas CPUs (núcleos SMT compartilhados e capacidade)
+ * - Amostra a ocupação das CPUs, do dispositivo de E/S, dos núcleos SMT e
+ *   das CPUs grandes
  */
-void execute_multicore_scheduling(const char* policy_labels[], char* log_buffer) {
-    handle_finished_processes(policy_labels, log_buffer);
-    handle_process_expansion(policy_labels, log_buffer);  
-    allocate_new_processes_to_cpus(policy_labels, log_buffer);
+static void execute_dispatch_cycle(const SchedClass* sched_class) {
+    bool woken = drain_arrivals(sched_class) > 0;
+    handle_finished_processes(sched_class);
+    handle_running_processes(sched_class, woken);
+    hotplug_apply();
+    tcb_reap_released();
+    handle_process_expansion(sched_class);
+    allocate_new_processes_to_cpus(sched_class);
+    capacity_migrate_misfits(sched_class);
+    tcb_fill_idle_cpus(sched_class);
+    tcb_release_for_queue(sched_class);
+    publish_cpus_held();
+    smt_publish_speed();
+    capacity_publish();
+    long now = calculate_elapsed_time();
+    io_account(now, busy_cpu_count());
+    smt_account(now, sched_class->has_queued() || has_held_processes());
+    capacity_account(now);
 }
-#endif
-
-#ifdef MULTI
 
 /* Verifica se há processos ativos em qualquer CPU */
 static bool check_active_processes_on_cpus(void) {
-    for (int processor = 0; processor < system_state.num_cpus; processor++) {
-        if (system_state.current_process_array[processor] != NULL) {
-            return true;
-        }
-    }
-    return false;
+    return __atomic_load_n(&system_state.busy_cpus, __ATOMIC_RELAXED) != 0;
 }
 
-/* Aguarda por processos prontos ou em execução */
-static bool wait_for_scheduler_activity(void) {
-    bool processes_active = check_active_processes_on_cpus();
+/* Aguarda por processos prontos, em execução ou bloqueados em E/S */
+static bool wait_for_scheduler_activity(const SchedClass* sched_class) {
+    bool processes_active = check_active_processes_on_cpus() || sched_class->has_queued() || io_busy() ||
+                            has_held_processes();
     
-    while (is_queue_empty(&system_state.ready_queue) && 
-           !system_state.generator_done && 
+    while (is_queue_empty(&system_state.ready_queue) &&
+           !system_state.generator_done &&
            !processes_active) {
         pthread_cond_wait(&system_state.scheduler_cv, &system_state.scheduler_mutex);
-        processes_active = check_active_processes_on_cpus();
+        processes_active = check_active_processes_on_cpus() || sched_class->has_queued() || io_busy() ||
+                           has_held_processes();
     }
     
-    return !(is_queue_empty(&system_state.ready_queue) && 
-             system_state.generator_done && 
+    return !(is_queue_empty(&system_state.ready_queue) &&
+             system_state.generator_done &&
              !processes_active);
 }
 
 /**
- * Executa um ciclo de escalonamento e espera por atividade do sistema
- * Chama as operações de escalonamento e aguarda mudanças no estado:
- * - Executa ciclo completo de escalonamento (processos finalizados, expansão, alocação)
- * - Aguarda sinalização de atividade (novos processos, finalizações, etc.)
- * Esta função é chamada no loop principal do escalonador
+ * Laço de despacho único para MONO (1 CPU) e MULTI (num_cpus CPUs)
+ * Toda decisão de política passa pela classe de escalonamento
  */
-static void execute_scheduling_cycle(const char* policy_labels[], char* log_buffer) {
-    execute_multicore_scheduling(policy_labels, log_buffer);
-    usleep(50); // Intervalo mínimo entre ciclos
+static void run_dispatch_loop(void) {
+    const SchedClass* sched_class = sched_class_of(system_state.scheduler_type);
+    if (sched_class == NULL) {
+        fprintf(stderr, "Erro: tipo de escalonador desconhecido\n");
+        return;
+    }
+    
+    add_log_message("Escalonador %s iniciado (%d CPU(s))\n", sched_class->name, system_state.num_cpus);
+    tcb_sched_init(sched_class);
+    io_init();
+    affinity_init();
+    topology_init();
+    smt_init();
+    capacity_init();
+    hotplug_init();
+    sched_class->init();
+    
+    while (true) {
+        pthread_mutex_lock(&system_state.scheduler_mutex);
+        bool should_continue = wait_for_scheduler_activity(sched_class);
+        pthread_mutex_unlock(&system_state.scheduler_mutex);
+        
+        if (!should_continue) {
+            break;
+        }
+        execute_dispatch_cycle(sched_class);
+        usleep(50); // Intervalo mínimo entre ciclos
+    }
+    
+    sched_class->exit();
+    io_destroy();
+    smt_exit();
+    add_log_message("Escalonador %s finalizado\n", sched_class->name);
+    log_scheduler_end();
+}
+
+/**
+ * Thread principal do escalonador (modo monoprocessador)
+ */
+void* scheduler_thread(void* arg) {
+    (void)arg; // Suprime warning de parâmetro não utilizado
+    run_dispatch_loop();
+    return NULL;
 }
 
+#ifdef MULTI
 /**
  * Função principal do escalonador multiprocessador (executa em thread separada)
- * Gerencia o ciclo de vida completo do escalonamento:
- * - Inicializa sistema de logging e estruturas de dados
- * - Cria 2 threads CPU para execução paralela de processos
- * - Executa loop principal de escalonamento até que todos os processos terminem
- * - Coordena operações de expansão de processos e finalizações
- * - Garante limpeza adequada de recursos ao final
+ * Usa o mesmo laço de despacho do monoprocessador sobre as num_cpus CPUs
  */
 void* multicore_scheduler_main(void* arg) {
     (void)arg; // Evitar warning de parâmetro não usado
+    run_dispatch_loop();
+    return NULL;
+}
+#endif
+
+void configure_process_state(PCB* pcb) {
+    if (pcb == NULL) return;
     
-    char log_buffer[256];
-    const char* policy_labels[] = {"", "FCFS", "RR", "PRIORITY", "CFS"};
+    pthread_mutex_lock(&pcb->mutex);
+    pcb->state = RUNNING;
+    pcb->should_preempt = 0;
+    pcb->dispatch_seq++;
+    pthread_cond_broadcast(&pcb->cv); // Acorda todas as threads do processo
+    pthread_mutex_unlock(&pcb->mutex);
     
-    add_log_message("[DEBUG] Iniciando escalonador multiprocessador\n");
+    metrics_on_dispatch(pcb);
+}
+
+void charge_switch_overhead(PCB* pcb, int last_cpu, int cpu) {
+    pcb->overhead_debt_ms += system_state.tunables.cs_cost_ms;
+    if (last_cpu < 0) {
+        return; // Primeiro despacho: não havia cache a perder
+    }
     
-    // Inicializa CFS se for a política escolhida
-    if (system_state.scheduler_type == CFS) {
-        cfs_init();
-        add_log_message("[DEBUG] CFS inicializado no modo multiprocessador\n");
+    // Recarga proporcional à parte fria do cache (toda, em outra CPU), pelo custo do nível
+    long now = calculate_elapsed_time();
+    bool migrated = last_cpu != cpu;
+    double cold = 1.0 - cache_warmth(pcb, last_cpu, cpu, now);
+    int miss = (int)(topo_migration_cost(last_cpu, cpu) * cold + 0.5);
+    if (migrated) {
+        pcb->migrations++;
+        topo_note_migration(last_cpu, cpu, now);
     }
+    pcb->overhead_debt_ms += miss;
+    affinity_note_dispatch(migrated, miss);
+}
+
+void request_process_preemption(PCB* pcb) {
+    if (pcb == NULL) return;
     
-    while (true) {
-        pthread_mutex_lock(&system_state.scheduler_mutex);
-        bool should_continue = wait_for_scheduler_activity();
-        pthread_mutex_unlock(&system_state.scheduler_mutex);
-        
-        if (!should_continue) {
-            break;
-        }
-        execute_scheduling_cycle(policy_labels, log_buffer);
+    pthread_mutex_lock(&pcb->mutex);
+    if (pcb->state == RUNNING) {
+        pcb->should_preempt = 1;
     }
+    pthread_mutex_unlock(&pcb->mutex);
+}
 
-    // Limpa CFS se foi usado
-    if (system_state.scheduler_type == CFS) {
-        cfs_cleanup();
-        add_log_message("[DEBUG] CFS finalizado no modo multiprocessador\n");
+/**
+ * Retira a CPU imediatamente; o bloco em andamento das threads é descartado
+ */
+void halt_process_execution(PCB* pcb) {
+    if (pcb == NULL) return;
+    
+    pthread_mutex_lock(&pcb->mutex);
+    if (pcb->state == RUNNING) {
+        pcb->state = pcb->io_pending ? BLOCKED : READY;
+        pcb->should_preempt = 0;
+        pcb->preempt_epoch++;
     }
+    pthread_mutex_unlock(&pcb->mutex);
+}
 
-    add_essential_log_message("Escalonador terminou execução de todos processos\n");
+PCB* find_higher_priority_process(int current_priority) {
+    PCB* highest_priority = get_highest_priority_process(&system_state.ready_queue);
+    
+    if (highest_priority != NULL && highest_priority->priority < current_priority) {
+        return highest_priority;
+    }
+    
     return NULL;
 }
 
+void pause_execution(int milliseconds) {
+    usleep(milliseconds * 1000);
+}
+
+long calculate_elapsed_time() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    long current_time = tv.tv_sec * 1000 + tv.tv_usec / 1000;
+    return current_time - system_state.start_time_ms;
+}
+
+/* Fração serial do processo (valor global quando não declarada) */
+static double process_serial_fraction(const PCB* pcb) {
+    int pct = pcb->serial_pct >= 0 ? pcb->serial_pct : system_state.tunables.serial_pct;
+    return pct / 100.0;
+}
+
+/* Threads que executam blocos ao mesmo tempo: todas, ou uma por CPU no despacho por thread */
+static int process_concurrent_threads(const PCB* pcb, int cpus) {
+    if (!system_state.tcb_sched) {
+        return pcb->num_threads;
+    }
+    int concurrent = cpus < pcb->num_threads ? cpus : pcb->num_threads;
+    return concurrent > 0 ? concurrent : 1;
+}
+
+double process_speedup(const PCB* pcb, int cpus) {
+    int parallel = cpus < pcb->num_threads ? cpus : pcb->num_threads;
+    if (parallel < 1) parallel = 1;
+    double serial = process_serial_fraction(pcb);
+    return 1.0 / (serial + (1.0 - serial) / parallel);
+}
+
+int thread_block_work_ms(const PCB* pcb, int cpus) {
+    if (!system_state.tunables.amdahl) {
+        return THREAD_EXECUTION_TIME;
+    }
+    // O bloco do processo rende THREAD_EXECUTION_TIME x speedup, dividido entre as threads que
+    // executam juntas (todas; no despacho por thread, só as que estão em CPU)
+    double process_work = THREAD_EXECUTION_TIME * process_speedup(pcb, cpus);
+    int concurrent = process_concurrent_threads(pcb, cpus);
+    int work = (int)(process_work / concurrent + 0.5);
+    return work > 0 ? work : 1;
+}
+
+long process_service_time_ms(const PCB* pcb, int work_ms) {
+    int cpus = pcb->num_threads < system_state.num_cpus ? pcb->num_threads : system_state.num_cpus;
+    long per_block = (long)thread_block_work_ms(pcb, cpus) * process_concurrent_threads(pcb, cpus);
+    long blocks = (work_ms + per_block - 1) / per_block;
+    return blocks * THREAD_EXECUTION_TIME;
+}
+
+int verify_all_processes_completed() {
+    for (int i = 0; i < system_state.process_count; i++) {
+        pthread_mutex_lock(&system_state.pcb_list[i].mutex);
+        if (system_state.pcb_list[i].state != FINISHED) {
+            pthread_mutex_unlock(&system_state.pcb_list[i].mutex);
+            return 0;
+        }
+        pthread_mutex_unlock(&system_state.pcb_list[i].mutex);
+    }
+    return 1;
+}
+
+void cleanup_scheduler() {
+#ifdef MULTI
+    pthread_mutex_destroy(&system_state.cpu2_mutex);
 #endif
+}
+
+void migrate_running_process(PCB* pcb, int from_cpu, int to_cpu) {
+    long now = calculate_elapsed_time();
+    set_cpu_process(to_cpu, pcb);
+    set_cpu_process(from_cpu, NULL);
+    affinity_note_leave(pcb, from_cpu, now);
+    topo_note_leave(pcb, from_cpu, now);
+    
+    pthread_mutex_lock(&pcb->mutex);
+    if (system_state.tcb_sched) {
+        tcb_move_cpu(from_cpu, to_cpu);
+    }
+    charge_switch_overhead(pcb, from_cpu, to_cpu);
+    pcb->last_cpu = to_cpu;
+    topo_note_dispatch(pcb, to_cpu, now);
+    pthread_mutex_unlock(&pcb->mutex);
+}
+
+/**
+ * Mapas de CPUs
+ * - Só o escalonador escreve; as operações atômicas deixam as leituras de
+ *   outras threads (métricas, threads dos processos) sem estado rasgado
+ * - idle_cpus = online_cpus sem busy_cpus, recalculado a cada escrita
+ */
+static void refresh_idle_cpus(void) {
+    CpuMask online = __atomic_load_n(&system_state.online_cpus, __ATOMIC_RELAXED);
+    CpuMask busy = __atomic_load_n(&system_state.busy_cpus, __ATOMIC_RELAXED);
+    __atomic_store_n(&system_state.idle_cpus, online & ~busy, __ATOMIC_RELEASE);
+}
+
+void set_cpu_process(int cpu, PCB* pcb) {
+    PCB* previous = system_state.current_process_array[cpu];
+    if (previous != NULL) {
+        __atomic_and_fetch(&previous->cpu_mask, ~CPU_BIT(cpu), __ATOMIC_RELAXED);
+    }
+    if (pcb != NULL) {
+        __atomic_or_fetch(&pcb->cpu_mask, CPU_BIT(cpu), __ATOMIC_RELAXED);
+        __atomic_or_fetch(&system_state.busy_cpus, CPU_BIT(cpu), __ATOMIC_RELAXED);
+    } else {
+        __atomic_and_fetch(&system_state.busy_cpus, ~CPU_BIT(cpu), __ATOMIC_RELAXED);
+    }
+    system_state.current_process_array[cpu] = pcb;
+    refresh_idle_cpus();
+}
+
+void set_cpu_online(int cpu, bool online) {
+    if (online) {
+        __atomic_or_fetch(&system_state.online_cpus, CPU_BIT(cpu), __ATOMIC_RELAXED);
+    } else {
+        __atomic_and_fetch(&system_state.online_cpus, ~CPU_BIT(cpu), __ATOMIC_RELAXED);
+    }
+    refresh_idle_cpus();
+}
+
+bool cpu_is_online(int cpu) {
+    return (__atomic_load_n(&system_state.online_cpus, __ATOMIC_RELAXED) & CPU_BIT(cpu)) != 0;
+}
+
+bool cpu_is_idle(int cpu) {
+    return (__atomic_load_n(&system_state.idle_cpus, __ATOMIC_ACQUIRE) & CPU_BIT(cpu)) != 0;
+}
+
+int next_idle_cpu(int from) {
+    if (from >= system_state.num_cpus) {
+        return -1;
+    }
+    CpuMask candidates = __atomic_load_n(&system_state.idle_cpus, __ATOMIC_ACQUIRE) & ~(CPU_BIT(from) - 1);
+    return candidates != 0 ? __builtin_ctzll(candidates) : -1;
+}
+
+int next_running_process_cpu(int from) {
+    if (from >= system_state.num_cpus) {
+        return -1;
+    }
+    CpuMask candidates = __atomic_load_n(&system_state.busy_cpus, __ATOMIC_RELAXED) & ~(CPU_BIT(from) - 1);
+    for (; candidates != 0; candidates &= candidates - 1) {
+        int cpu = __builtin_ctzll(candidates);
+        if (!is_process_on_earlier_cpu(system_state.current_process_array[cpu], cpu)) {
+            return cpu;
+        }
+    }
+    return -1;
+}
+
+int idle_cpu_count(void) {
+    return __builtin_popcountll(__atomic_load_n(&system_state.idle_cpus, __ATOMIC_ACQUIRE));
+}
+
+int busy_cpu_count(void) {
+    return __builtin_popcountll(__atomic_load_n(&system_state.busy_cpus, __ATOMIC_RELAXED));
+}
+
+int online_cpus(void) {
+    return __builtin_popcountll(__atomic_load_n(&system_state.online_cpus, __ATOMIC_RELAXED));
+}
+
+CpuMask cpu_mask_of_process(const PCB* pcb) {
+    return __atomic_load_n(&pcb->cpu_mask, __ATOMIC_RELAXED);
+}
+
+int cpus_of_process(const PCB* pcb) {
+    return __builtin_popcountll(__atomic_load_n(&pcb->cpu_mask, __ATOMIC_RELAXED));
+}
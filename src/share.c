@@ -0,0 +1,269 @@
+#include "../lib/sched_class.h"
+#include "../lib/scheduler.h"
+#include "../lib/rbtree.h"
+#include "../lib/log.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * Escalonadores de fatia proporcional por bilhetes
+ * - STRIDE (determinístico): cada processo avança seu pass em STRIDE1 / bilhetes
+ *   por quantum executado; executa o menor pass (leftmost da Red-Black Tree)
+ * - LOTTERY (aleatório): sorteia um bilhete entre os prontos; a árvore guarda a
+ *   soma de bilhetes das subárvores, então o sorteio é O(log n)
+ * Bilhetes vêm da opção tickets=N (por processo) ou da prioridade:
+ * (6 - prioridade) * 100, ou seja, prioridade 1 = 500 e prioridade 5 = 100
+ * Ambas medem o tempo de CPU recebido contra a fatia ideal de cada processo
+ */
+
+#define STRIDE1 (1LL << 20)     // Constante do stride (precisão do pass)
+
+// Apenas uma política por execução: a árvore é do STRIDE ou da LOTTERY
+static RBRoot share_tree = RB_ROOT_INIT;
+static long long global_pass;   // pass do último processo escolhido (entrada de novos)
+static uint64_t lottery_state;  // Estado do gerador pseudoaleatório
+
+// Processos ativos (chegaram e não terminaram) para a fatia ideal
+static PCB** active;
+static int nr_active;
+static long long active_tickets;
+static long last_account_ms;
+
+static inline PCB* share_task_of(RBNode* node) {
+    return node ? rb_entry(node, PCB, share_node) : NULL;
+}
+
+static bool share_on_tree(PCB* process) {
+    return process->share_node.rb_parent != NULL || share_tree.rb_node == &process->share_node;
+}
+
+static int share_tickets_of(const PCB* process) {
+    if (process->tickets > 0) {
+        return process->tickets;
+    }
+    return (6 - process->priority) * 100;
+}
+
+/* xorshift64*: sequência reproduzível a partir de lottery_seed */
+static uint64_t lottery_next(void) {
+    lottery_state ^= lottery_state >> 12;
+    lottery_state ^= lottery_state << 25;
+    lottery_state ^= lottery_state >> 27;
+    return lottery_state * 2685821657736338717ULL;
+}
+
+/* CPUs ocupadas pelo processo no momento */
+static int share_cpus_of(const PCB* process) {
+    return cpus_of_process(process);
+}
+
+/**
+ * Acumula, desde a última contabilização, o tempo de CPU recebido e o devido
+ * pela fatia ideal (num_cpus * bilhetes / bilhetes ativos, limitada às CPUs
+ * que o processo consegue ocupar)
+ */
+static void share_account(long now_ms) {
+    long delta = now_ms - last_account_ms;
+    if (delta <= 0) {
+        return;
+    }
+    last_account_ms = now_ms;
+    if (active_tickets <= 0) {
+        return;
+    }
+    
+    for (int i = 0; i < nr_active; i++) {
+        PCB* process = active[i];
+        int max_cpus = process->num_threads < system_state.num_cpus ? process->num_threads : system_state.num_cpus;
+        double share = (double)system_state.num_cpus * share_tickets_of(process) / active_tickets;
+        if (share > max_cpus) share = max_cpus;
+        
+        process->share_ideal_ms += share * delta;
+        process->share_received_ms += (long)share_cpus_of(process) * delta;
+    }
+}
+
+static void share_init(void) {
+    rb_init(&share_tree);
+    global_pass = 0;
+    lottery_state = system_state.tunables.lottery_seed ? system_state.tunables.lottery_seed : 1;
+    active = malloc(system_state.process_count * sizeof(PCB*));
+    nr_active = 0;
+    active_tickets = 0;
+    last_account_ms = calculate_elapsed_time();
+}
+
+static void share_exit(void) {
+    rb_init(&share_tree);
+    free(active);
+    active = NULL;
+    nr_active = 0;
+}
+
+/* Processo chegou: passa a disputar a CPU e a contar para a fatia ideal */
+static void share_activate(PCB* process) {
+    share_account(calculate_elapsed_time());
+    if (active != NULL) {
+        active[nr_active++] = process;
+    }
+    active_tickets += share_tickets_of(process);
+}
+
+/* Processo terminou: sai da árvore (se estiver nela) e da fatia ideal */
+static void share_dequeue(PCB* process) {
+    share_account(calculate_elapsed_time());
+    if (share_on_tree(process)) {
+        rb_remove(&share_tree, &process->share_node);
+    }
+    for (int i = 0; i < nr_active; i++) {
+        if (active[i] == process) {
+            active[i] = active[--nr_active];
+            active_tickets -= share_tickets_of(process);
+            break;
+        }
+    }
+}
+
+static bool share_has_queued(void) {
+    return !rb_is_empty(&share_tree);
+}
+
+/* Quantum esgotado quando o bloco em andamento o completa */
+static bool share_tick(PCB* curr, long now_ms) {
+    share_account(now_ms);
+    long used = now_ms - curr->share_dispatch_ms;
+    return used + THREAD_EXECUTION_TIME >= system_state.quantum;
+}
+
+static bool share_no_preempt(PCB* curr) {
+    (void)curr;
+    return false;
+}
+
+/* ========== STRIDE ========== */
+
+static inline bool stride_pass_less(const PCB* a, const PCB* b) {
+    return a->pass < b->pass;
+}
+
+RB_DEFINE_INSERT(stride_tree_insert, PCB, share_node, stride_pass_less)
+
+static void stride_enqueue(PCB* process) {
+    share_activate(process);
+    process->stride = STRIDE1 / share_tickets_of(process);
+    // Entra no pass atual do sistema: não herda crédito nem dívida de quem já executou
+    process->pass = global_pass + process->stride;
+    stride_tree_insert(&share_tree, process);
+}
+
+static PCB* stride_pick_next(void) {
+    long now = calculate_elapsed_time();
+    share_account(now);
+    PCB* process = share_task_of(rb_leftmost(&share_tree));
+    if (process != NULL) {
+        rb_remove(&share_tree, &process->share_node);
+        global_pass = process->pass;
+        process->share_dispatch_ms = now;
+    }
+    return process;
+}
+
+/* Avança o pass proporcionalmente aos quanta executados neste despacho */
+static void stride_put_prev(PCB* process) {
+    long ran = calculate_elapsed_time() - process->share_dispatch_ms;
+    long long quanta_x1000 = ran * 1000LL / system_state.quantum;
+    if (quanta_x1000 < 1000) quanta_x1000 = 1000;
+    process->pass += process->stride * quanta_x1000 / 1000;
+    stride_tree_insert(&share_tree, process);
+}
+
+static void stride_log_dispatch(PCB* process, int cpu) {
+    add_log_message("[STRIDE] Processo PID %d (bilhetes %d, pass %lld)\n",
+                    process->pid, share_tickets_of(process), process->pass);
+#ifdef MULTI
+    log_process_start_cpu("STRIDE", process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start("STRIDE", process->pid);
+#endif
+}
+
+const SchedClass stride_sched_class = {
+    .name = "STRIDE",
+    .init = share_init,
+    .exit = share_exit,
+    .enqueue = stride_enqueue,
+    .dequeue = share_dequeue,
+    .pick_next = stride_pick_next,
+    .put_prev = stride_put_prev,
+    .tick = share_tick,
+    .check_preempt = share_no_preempt,
+    .has_queued = share_has_queued,
+    .log_dispatch = stride_log_dispatch,
+};
+
+/* ========== LOTTERY ========== */
+
+// Ordem da árvore é irrelevante para o sorteio; PID mantém a árvore determinística
+static inline bool lottery_pid_less(const PCB* a, const PCB* b) {
+    return a->pid < b->pid;
+}
+
+RB_DEFINE_INSERT(lottery_tree_insert, PCB, share_node, lottery_pid_less)
+
+static void lottery_insert(PCB* process) {
+    process->share_node.rb_weight = share_tickets_of(process);
+    lottery_tree_insert(&share_tree, process);
+}
+
+static void lottery_enqueue(PCB* process) {
+    share_activate(process);
+    lottery_insert(process);
+}
+
+/* Sorteia um bilhete em [0, total) e desce pela soma de bilhetes das subárvores */
+static PCB* lottery_pick_next(void) {
+    long now = calculate_elapsed_time();
+    share_account(now);
+    long long total = rb_total_weight(&share_tree);
+    if (total <= 0) {
+        return NULL;
+    }
+    
+    long long winner = (long long)(lottery_next() % (uint64_t)total);
+    PCB* process = share_task_of(rb_select_by_weight(&share_tree, winner));
+    if (process != NULL) {
+        rb_remove(&share_tree, &process->share_node);
+        process->share_dispatch_ms = now;
+    }
+    return process;
+}
+
+static void lottery_put_prev(PCB* process) {
+    lottery_insert(process);
+}
+
+static void lottery_log_dispatch(PCB* process, int cpu) {
+    add_log_message("[LOTTERY] Processo PID %d sorteado (bilhetes %d)\n",
+                    process->pid, share_tickets_of(process));
+#ifdef MULTI
+    log_process_start_cpu("LOTTERY", process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start("LOTTERY", process->pid);
+#endif
+}
+
+const SchedClass lottery_sched_class = {
+    .name = "LOTTERY",
+    .init = share_init,
+    .exit = share_exit,
+    .enqueue = lottery_enqueue,
+    .dequeue = share_dequeue,
+    .pick_next = lottery_pick_next,
+    .put_prev = lottery_put_prev,
+    .tick = share_tick,
+    .check_preempt = share_no_preempt,
+    .has_queued = share_has_queued,
+    .log_dispatch = lottery_log_dispatch,
+};
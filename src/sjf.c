@@ -0,0 +1,118 @@
+#include "../lib/sched_class.h"
+#include "../lib/scheduler.h"
+#include "../lib/heap.h"
+#include "../lib/log.h"
+
+/**
+ * Shortest Job First e Shortest Remaining Time First
+ * - Prontos em um min-heap ordenado pelo tempo restante (empate: chegada, PID)
+ * - SJF não preempta: o processo escolhido executa até terminar
+ * - SRTF preempta, na fronteira do bloco, quando chega um processo com tempo
+ *   restante menor que o do processo em execução
+ */
+
+static ProcessHeap run_heap;
+
+static bool sjf_remaining_less(const PCB* a, const PCB* b) {
+    if (a->remaining_time != b->remaining_time) {
+        return a->remaining_time < b->remaining_time;
+    }
+    if (a->start_time != b->start_time) {
+        return a->start_time < b->start_time;
+    }
+    return a->pid < b->pid;
+}
+
+static void sjf_init(void) {
+    heap_init(&run_heap, system_state.process_count, sjf_remaining_less);
+}
+
+static void sjf_exit(void) {
+    heap_destroy(&run_heap);
+}
+
+static void sjf_enqueue(PCB* process) {
+    heap_push(&run_heap, process);
+}
+
+static void sjf_dequeue(PCB* process) {
+    heap_remove(&run_heap, process);
+}
+
+static PCB* sjf_pick_next(void) {
+    return heap_pop(&run_heap);
+}
+
+static bool sjf_has_queued(void) {
+    return !heap_is_empty(&run_heap);
+}
+
+static bool sjf_no_tick(PCB* curr, long now_ms) {
+    (void)curr;
+    (void)now_ms;
+    return false;
+}
+
+static bool sjf_no_preempt(PCB* curr) {
+    (void)curr;
+    return false;
+}
+
+static void sjf_log_dispatch(PCB* process, int cpu) {
+#ifdef MULTI
+    log_process_start_cpu("SJF", process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start("SJF", process->pid);
+#endif
+}
+
+const SchedClass sjf_sched_class = {
+    .name = "SJF",
+    .init = sjf_init,
+    .exit = sjf_exit,
+    .enqueue = sjf_enqueue,
+    .dequeue = sjf_dequeue,
+    .pick_next = sjf_pick_next,
+    .put_prev = sjf_enqueue,
+    .tick = sjf_no_tick,
+    .check_preempt = sjf_no_preempt,
+    .has_queued = sjf_has_queued,
+    .log_dispatch = sjf_log_dispatch,
+};
+
+/* ========== SRTF ========== */
+
+static bool srtf_check_preempt(PCB* curr) {
+    PCB* shortest = heap_peek(&run_heap);
+    if (shortest == NULL || shortest->remaining_time >= curr->remaining_time) {
+        return false;
+    }
+    add_log_message("[SRTF] Processo PID %d (restante %dms) preemptado por PID %d (restante %dms)\n",
+                    curr->pid, curr->remaining_time, shortest->pid, shortest->remaining_time);
+    return true;
+}
+
+static void srtf_log_dispatch(PCB* process, int cpu) {
+    add_log_message("[SRTF] Processo PID %d com %dms restantes\n", process->pid, process->remaining_time);
+#ifdef MULTI
+    log_process_start_cpu("SRTF", process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start("SRTF", process->pid);
+#endif
+}
+
+const SchedClass srtf_sched_class = {
+    .name = "SRTF",
+    .init = sjf_init,
+    .exit = sjf_exit,
+    .enqueue = sjf_enqueue,
+    .dequeue = sjf_dequeue,
+    .pick_next = sjf_pick_next,
+    .put_prev = sjf_enqueue,
+    .tick = sjf_no_tick,
+    .check_preempt = srtf_check_preempt,
+    .has_queued = sjf_has_queued,
+    .log_dispatch = srtf_log_dispatch,
+};
@@ -0,0 +1,157 @@
+#include "../lib/sched_class.h"
+#include "../lib/scheduler.h"
+#include "../lib/rbtree.h"
+#include "../lib/log.h"
+#include "../lib/cfs.h"
+
+/**
+ * Escalonador orientado a SLO de latência
+ * - Processos podem declarar slo=MS: alvo para concluir após a chegada
+ * - Folga = (chegada + SLO - agora) - trabalho restante em tempo de parede
+ * - Todos os processos ficam na árvore do CFS; os que têm SLO também ficam em
+ *   uma Red-Black Tree ordenada por (chegada + SLO - trabalho restante), que é a
+ *   folga sem o "agora" e não muda enquanto o processo espera
+ * - Sob pressão (menor folga <= slo_pressure ms) executa o de menor folga;
+ *   sem pressão o CFS decide sozinho
+ */
+
+static RBRoot slack_tree = RB_ROOT_INIT;
+
+/* Instante em que a folga do processo chega a zero */
+static long slo_zero_slack_ms(const PCB* process) {
+    return process->abs_deadline_ms - process_service_time_ms(process, process->remaining_time);
+}
+
+static inline bool slo_slack_less(const PCB* a, const PCB* b) {
+    return slo_zero_slack_ms(a) < slo_zero_slack_ms(b);
+}
+
+RB_DEFINE_INSERT(slo_tree_insert, PCB, dl_node, slo_slack_less)
+
+static inline PCB* slo_task_of(RBNode* node) {
+    return node ? rb_entry(node, PCB, dl_node) : NULL;
+}
+
+static bool has_slo(const PCB* process) {
+    return process->slo_ms > 0;
+}
+
+static void slo_tree_remove(PCB* process) {
+    if (process->dl_node.rb_parent != NULL || slack_tree.rb_node == &process->dl_node) {
+        rb_remove(&slack_tree, &process->dl_node);
+    }
+}
+
+/**
+ * Processo com SLO mais urgente, se a folga dele estiver sob pressão
+ * Pula os estrangulados pela quota do CFS: ficam na árvore, mas só voltam
+ * a disputar a CPU depois da recarga do pool
+ */
+static PCB* slo_urgent(long now_ms) {
+    RBNode* node = rb_leftmost(&slack_tree);
+    while (node != NULL && cfs_is_throttled(slo_task_of(node))) {
+        node = rb_next(node);
+    }
+    PCB* process = slo_task_of(node);
+    if (process == NULL || slo_zero_slack_ms(process) - now_ms > system_state.tunables.slo_pressure_ms) {
+        return NULL;
+    }
+    return process;
+}
+
+/* urgent deve tomar a CPU de curr (curr sem SLO ou com mais folga) */
+static bool slo_should_displace(const PCB* urgent, const PCB* curr) {
+    return urgent != NULL && (!has_slo(curr) || slo_slack_less(urgent, curr));
+}
+
+static void slo_init(void) {
+    rb_init(&slack_tree);
+    cfs_sched_class.init();
+}
+
+static void slo_exit(void) {
+    rb_init(&slack_tree);
+    cfs_sched_class.exit();
+}
+
+static void slo_enqueue(PCB* process) {
+    if (has_slo(process)) {
+        process->abs_deadline_ms = (long)process->start_time + process->slo_ms;
+        slo_tree_insert(&slack_tree, process);
+    }
+    cfs_sched_class.enqueue(process);
+}
+
+static void slo_dequeue(PCB* process) {
+    slo_tree_remove(process);
+    cfs_sched_class.dequeue(process);
+}
+
+static PCB* slo_pick_next(void) {
+    PCB* process = slo_urgent(calculate_elapsed_time());
+    if (process != NULL) {
+        // Sob pressão: sai das duas árvores com fatia nova; o CFS ainda cobra o vruntime no put_prev
+        slo_tree_remove(process);
+        cfs_pick_process(process);
+        process->slo_boosted = 1;
+        return process;
+    }
+    
+    process = cfs_sched_class.pick_next();
+    if (process != NULL) {
+        slo_tree_remove(process);
+        process->slo_boosted = 0;
+    }
+    return process;
+}
+
+static void slo_put_prev(PCB* process) {
+    cfs_sched_class.put_prev(process);
+    if (has_slo(process)) {
+        slo_tree_insert(&slack_tree, process);
+    }
+}
+
+static bool slo_tick(PCB* curr, long now_ms) {
+    bool displaced = slo_should_displace(slo_urgent(now_ms), curr);
+    return cfs_sched_class.tick(curr, now_ms) || displaced;
+}
+
+static bool slo_check_preempt(PCB* curr) {
+    PCB* urgent = slo_urgent(calculate_elapsed_time());
+    if (slo_should_displace(urgent, curr)) {
+        add_log_message("[SLO] Processo PID %d preemptado por PID %d (folga %ldms)\n", curr->pid, urgent->pid,
+                        slo_zero_slack_ms(urgent) - calculate_elapsed_time());
+        return true;
+    }
+    return cfs_sched_class.check_preempt(curr);
+}
+
+static void slo_log_dispatch(PCB* process, int cpu) {
+    if (process->slo_boosted) {
+        add_log_message("[SLO] Processo PID %d escolhido pela folga (%ldms)\n",
+                        process->pid, slo_zero_slack_ms(process) - calculate_elapsed_time());
+    } else {
+        add_log_message("[SLO] Processo PID %d escolhido pelo CFS\n", process->pid);
+    }
+#ifdef MULTI
+    log_process_start_cpu("SLO", process->pid, cpu);
+#else
+    (void)cpu;
+    log_process_start("SLO", process->pid);
+#endif
+}
+
+const SchedClass slo_sched_class = {
+    .name = "SLO",
+    .init = slo_init,
+    .exit = slo_exit,
+    .enqueue = slo_enqueue,
+    .dequeue = slo_dequeue,
+    .pick_next = slo_pick_next,
+    .put_prev = slo_put_prev,
+    .tick = slo_tick,
+    .check_preempt = slo_check_preempt,
+    .has_queued = cfs_has_processes,
+    .log_dispatch = slo_log_dispatch,
+};
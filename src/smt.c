@@ -0,0 +1,153 @@
+#include "../lib/smt.h"
+#include "../lib/scheduler.h"
+#include "../lib/topology.h"
+#include "../lib/log.h"
+#include <stdlib.h>
+
+/**
+ * Núcleos SMT simulados
+ * - O núcleo de uma CPU é cpu / smt_width(): as threads SMT da topologia
+ *   (topology=N:L:C:T) ou pares de CPUs sem topologia
+ * - O rendimento é publicado no PCB a cada ciclo (como as CPUs ocupadas no
+ *   modelo de Amdahl) e as threads descontam o bloco proporcionalmente
+ * - Core scheduling: grupo 0 (sem trust=) é compatível só com o grupo 0;
+ *   um processo é sempre compatível consigo mesmo
+ * - Recusados esperam em ordem de recusa e voltam antes da classe quando
+ *   uma CPU compatível fica livre (devolver à classe a cada ciclo cobraria
+ *   fatias que não executaram)
+ */
+
+static PCB** waiting;           // Recusados pelo core scheduling, em ordem de recusa
+static int nr_waiting;
+static long last_account_ms;    // Última amostragem (-1 = nenhuma)
+static SMTStats stats;
+
+void smt_init(void) {
+    int capacity = system_state.process_count > 0 ? system_state.process_count : 1;
+    waiting = malloc(capacity * sizeof(PCB*));
+    nr_waiting = 0;
+    last_account_ms = -1;
+    stats = (SMTStats){ 0 };
+}
+
+void smt_exit(void) {
+    free(waiting);
+    waiting = NULL;
+}
+
+int smt_width(void) {
+    if (!system_state.tunables.smt) {
+        return 1;
+    }
+    int width = topology_cpus() > 0 ? system_state.tunables.topo_smt : 2;
+    return width < system_state.num_cpus ? width : system_state.num_cpus;
+}
+
+/* Outra CPU do mesmo núcleo ocupada */
+static bool sibling_busy(int cpu) {
+    int first = cpu - cpu % smt_width();
+    for (int other = first; other < first + smt_width() && other < system_state.num_cpus; other++) {
+        if (other != cpu && system_state.current_process_array[other] != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool core_sched_allows(const PCB* pcb, int cpu) {
+    if (!system_state.tunables.core_sched || smt_width() == 1) {
+        return true;
+    }
+    
+    int first = cpu - cpu % smt_width();
+    for (int other = first; other < first + smt_width() && other < system_state.num_cpus; other++) {
+        PCB* running = system_state.current_process_array[other];
+        if (other != cpu && running != NULL && running != pcb && running->trust_group != pcb->trust_group) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int core_sched_select_cpu(PCB* pcb, int cpu) {
+    if (core_sched_allows(pcb, cpu)) {
+        return cpu;
+    }
+    for (int other = 0; other < system_state.num_cpus; other++) {
+        if (cpu_is_idle(other) && core_sched_allows(pcb, other)) {
+            return other;
+        }
+    }
+    return -1;
+}
+
+void core_sched_hold(PCB* pcb) {
+    waiting[nr_waiting++] = pcb;
+    stats.refusals++;
+    add_log_message("[CORE] PID %d (grupo %d) aguarda um nucleo sem outro grupo\n", pcb->pid, pcb->trust_group);
+}
+
+PCB* core_sched_take_waiting(int cpu) {
+    for (int index = 0; index < nr_waiting; index++) {
+        PCB* pcb = waiting[index];
+        if (core_sched_allows(pcb, cpu)) {
+            for (int next = index + 1; next < nr_waiting; next++) {
+                waiting[next - 1] = waiting[next];
+            }
+            nr_waiting--;
+            return pcb;
+        }
+    }
+    return NULL;
+}
+
+bool core_sched_has_waiting(void) {
+    return nr_waiting > 0;
+}
+
+void smt_publish_speed(void) {
+    if (smt_width() == 1) return;
+    
+    for (int cpu = next_running_process_cpu(0); cpu >= 0; cpu = next_running_process_cpu(cpu + 1)) {
+        PCB* process = system_state.current_process_array[cpu];
+        int held = cpus_of_process(process);
+        int speed = 0;
+        for (CpuMask cpus = cpu_mask_of_process(process); cpus != 0; cpus &= cpus - 1) {
+            speed += sibling_busy(__builtin_ctzll(cpus)) ? system_state.tunables.smt_share_pct : 100;
+        }
+        pthread_mutex_lock(&process->mutex);
+        process->smt_speed_pct = speed / held;
+        pthread_mutex_unlock(&process->mutex);
+    }
+}
+
+void smt_account(long now_ms, bool queued) {
+    if (smt_width() == 1) return;
+    
+    if (last_account_ms >= 0) {
+        long interval = now_ms - last_account_ms;
+        for (int first = 0; first < system_state.num_cpus; first += smt_width()) {
+            int busy = 0;
+            int idle = 0;
+            for (int cpu = first; cpu < first + smt_width() && cpu < system_state.num_cpus; cpu++) {
+                if (system_state.current_process_array[cpu] != NULL) {
+                    busy++;
+                } else if (cpu_is_online(cpu)) {
+                    idle++;
+                }
+            }
+            stats.core_ms += interval;
+            if (busy > 1) {
+                stats.shared_ms += interval;
+            }
+            if (system_state.tunables.core_sched && queued && busy > 0) {
+                stats.forced_idle_ms += interval * idle;
+            }
+        }
+    }
+    last_account_ms = now_ms;
+}
+
+void smt_get_stats(SMTStats* out) {
+    *out = stats;
+}
@@ -0,0 +1,243 @@
+#include "../lib/tcb_sched.h"
+#include "../lib/log.h"
+#include "../lib/scheduler.h"
+#include "../lib/topology.h"
+#include "../lib/smt.h"
+#include <stdlib.h>
+
+/**
+ * Despacho por thread (thread_sched=1)
+ * - current_thread_array acompanha current_process_array: cada CPU ocupada
+ *   tem a thread do processo que executa nela
+ * - Só as threads em CPU executam blocos; com um processo em uma CPU, um
+ *   processo de 4 threads avança um bloco por vez, não quatro
+ * - As irmãs ocupam CPUs que a classe deixou livres (trabalho conservado) e
+ *   devolvem uma por vez, no fim do bloco, quando há processos esperando
+ * - Distância entre CPUs é o nível da topologia que as separa ou, sem
+ *   topologia, a diferença dos índices
+ */
+
+/* Thread fora de CPU com menos tempo de CPU (NULL = todas em CPUs) */
+static TCB* idle_thread_of(PCB* pcb) {
+    TCB* best = NULL;
+    for (int index = 0; index < pcb->num_threads; index++) {
+        TCB* tcb = &pcb->tcbs[index];
+        if (tcb->cpu < 0 && (best == NULL || tcb->run_ms < best->run_ms)) {
+            best = tcb;
+        }
+    }
+    return best;
+}
+
+/**
+ * Liga a thread à CPU (mutex do processo travado ou processo fora de RUNNING)
+ * A primeira thread é cobrada no despacho do processo; as irmãs, aqui
+ */
+static void bind_thread(TCB* tcb, int cpu, bool sibling) {
+    if (tcb->last_cpu >= 0 && tcb->last_cpu != cpu) {
+        tcb->migrations++;
+    }
+    if (sibling) {
+        charge_switch_overhead(tcb->pcb, tcb->last_cpu, cpu);
+    }
+    tcb->cpu = cpu;
+    tcb->last_cpu = cpu;
+    tcb->release = 0;
+    tcb->dispatches++;
+    system_state.current_thread_array[cpu] = tcb;
+}
+
+/**
+ * CPU livre para mais uma thread do processo (que o core scheduling permite)
+ * Dica close: a mais próxima de uma irmã; spread: a mais distante
+ */
+static int sibling_cpu(const PCB* pcb) {
+    int best = -1;
+    int best_distance = 0;
+    for (int cpu = next_idle_cpu(0); cpu >= 0; cpu = next_idle_cpu(cpu + 1)) {
+        if (!core_sched_allows(pcb, cpu)) continue;
+        
+        int distance = system_state.num_cpus;
+        for (int other = 0; other < system_state.num_cpus; other++) {
+            int apart = topology_cpus() > 0 ? (int)topo_level(cpu, other) : abs(cpu - other);
+            if (system_state.current_process_array[other] == pcb && apart < distance) {
+                distance = apart;
+            }
+        }
+        bool better = pcb->siblings_spread ? distance > best_distance : distance < best_distance;
+        if (best < 0 || better) {
+            best = cpu;
+            best_distance = distance;
+        }
+    }
+    return best;
+}
+
+/* Processo em execução com threads fora de CPU e a menor fração de threads em CPU */
+static PCB* neediest_process(void) {
+    PCB* best = NULL;
+    double best_share = 0.0;
+    for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+        PCB* pcb = system_state.current_process_array[cpu];
+        if (pcb == NULL || pcb == best || pcb->tcbs == NULL) continue;
+        
+        int held = cpus_of_process(pcb);
+        if (held >= pcb->num_threads) continue;
+        
+        pthread_mutex_lock(&pcb->mutex);
+        bool running = pcb->state == RUNNING && !pcb->should_preempt;
+        pthread_mutex_unlock(&pcb->mutex);
+        
+        double share = (double)held / pcb->num_threads;
+        if (running && (best == NULL || share < best_share)) {
+            best = pcb;
+            best_share = share;
+        }
+    }
+    return best;
+}
+
+void tcb_sched_init(const SchedClass* sched_class) {
+    system_state.tcb_sched = system_state.tunables.thread_sched && !sched_class->gang;
+    for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
+        system_state.current_thread_array[cpu] = NULL;
+    }
+    if (system_state.tunables.thread_sched && sched_class->gang) {
+        add_log_message("Despacho por thread ignorado: %s ja ocupa uma CPU por thread\n", sched_class->name);
+    }
+}
+
+void tcb_bind_first(PCB* pcb, int cpu) {
+    if (!system_state.tcb_sched || pcb->tcbs == NULL) return;
+    
+    pthread_mutex_lock(&pcb->mutex);
+    TCB* tcb = idle_thread_of(pcb);
+    if (tcb != NULL) {
+        bind_thread(tcb, cpu, false);
+    }
+    pthread_mutex_unlock(&pcb->mutex);
+}
+
+/* Sem travar o mutex: o processo está fora de RUNNING ou o chamador já o travou */
+void tcb_unbind_cpu(int cpu) {
+    TCB* tcb = system_state.current_thread_array[cpu];
+    if (tcb == NULL) return;
+    
+    if (tcb->cpu == cpu) {
+        tcb->cpu = -1;
+        tcb->release = 0;
+    }
+    system_state.current_thread_array[cpu] = NULL;
+}
+
+void tcb_move_cpu(int from_cpu, int to_cpu) {
+    TCB* tcb = system_state.current_thread_array[from_cpu];
+    if (tcb == NULL) return;
+    
+    system_state.current_thread_array[from_cpu] = NULL;
+    if (tcb->cpu == from_cpu) {
+        tcb->cpu = to_cpu;
+        tcb->last_cpu = to_cpu;
+        tcb->migrations++;
+    }
+    system_state.current_thread_array[to_cpu] = tcb;
+}
+
+int tcb_reap_released(void) {
+    if (!system_state.tcb_sched) return 0;
+    
+    int freed = 0;
+    for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+        TCB* tcb = system_state.current_thread_array[cpu];
+        if (tcb == NULL) continue;
+        
+        pthread_mutex_lock(&tcb->pcb->mutex);
+        bool left = tcb->cpu != cpu;
+        pthread_mutex_unlock(&tcb->pcb->mutex);
+        
+        if (left) {
+            system_state.current_thread_array[cpu] = NULL;
+            set_cpu_process(cpu, NULL);
+            add_log_message("[THREADS] PID %d: thread %d devolveu a CPU %d\n",
+                            tcb->pcb->pid, tcb->thread_index, cpu);
+            freed++;
+        }
+    }
+    return freed;
+}
+
+void tcb_fill_idle_cpus(const SchedClass* sched_class) {
+    // Com processos na fila a CPU livre é deles (núcleo incompatível, CPU quente);
+    // ocupar aqui só faria tcb_release_for_queue devolvê-la no mesmo ciclo
+    if (!system_state.tcb_sched || sched_class->has_queued()) return;
+    
+    // CPU ainda livre depois da alocação: a classe não tem processo para ela
+    PCB* pcb;
+    while ((pcb = neediest_process()) != NULL) {
+        int cpu = sibling_cpu(pcb);
+        if (cpu < 0) return;
+        
+        pthread_mutex_lock(&pcb->mutex);
+        TCB* tcb = pcb->state == RUNNING && !pcb->should_preempt ? idle_thread_of(pcb) : NULL;
+        if (tcb != NULL) {
+            bind_thread(tcb, cpu, true);
+            set_cpu_process(cpu, pcb);
+            pthread_cond_broadcast(&pcb->cv);
+        }
+        pthread_mutex_unlock(&pcb->mutex);
+        if (tcb == NULL) return;
+        
+        add_log_message("[THREADS] PID %d: thread %d na CPU %d (%d de %d threads em CPU)\n",
+                        pcb->pid, tcb->thread_index, cpu, cpus_of_process(pcb), pcb->num_threads);
+    }
+}
+
+void tcb_release_for_queue(const SchedClass* sched_class) {
+    if (!system_state.tcb_sched || !sched_class->has_queued()) return;
+    
+    // Uma devolução pendente por vez; CPU online livre significa que a classe não tem quem
+    // despachar (CPU fora de linha não tem thread e não conta)
+    for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+        TCB* tcb = system_state.current_thread_array[cpu];
+        if (tcb == NULL && !cpu_is_online(cpu)) continue;
+        if (tcb == NULL) return;
+        
+        pthread_mutex_lock(&tcb->pcb->mutex);
+        bool pending = tcb->release;
+        pthread_mutex_unlock(&tcb->pcb->mutex);
+        if (pending) return;
+    }
+    
+    // Processo com mais CPUs devolve a da irmã com mais tempo de CPU
+    PCB* widest = NULL;
+    int widest_cpus = 1;
+    for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+        PCB* pcb = system_state.current_process_array[cpu];
+        int held = pcb != NULL ? cpus_of_process(pcb) : 0;
+        if (held > widest_cpus) {
+            widest = pcb;
+            widest_cpus = held;
+        }
+    }
+    if (widest == NULL) return;
+    
+    TCB* victim = NULL;
+    for (int cpu = 0; cpu < system_state.num_cpus; cpu++) {
+        TCB* tcb = system_state.current_thread_array[cpu];
+        if (tcb != NULL && tcb->pcb == widest && (victim == NULL || tcb->run_ms > victim->run_ms)) {
+            victim = tcb;
+        }
+    }
+    
+    pthread_mutex_lock(&widest->mutex);
+    bool requested = widest->state == RUNNING && !widest->should_preempt && victim->cpu >= 0;
+    if (requested) {
+        victim->release = 1;
+    }
+    pthread_mutex_unlock(&widest->mutex);
+    
+    if (requested) {
+        add_log_message("[THREADS] PID %d: thread %d devolve a CPU %d no fim do bloco (processos esperando)\n",
+                        widest->pid, victim->thread_index, victim->cpu);
+    }
+}
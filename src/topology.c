@@ -0,0 +1,97 @@
+#include "../lib/topology.h"
+#include "../lib/log.h"
+
+/**
+ * Domínios de escalonamento sobre a topologia simulada
+ * - O nível de uma migração é o menor domínio comum às duas CPUs
+ * - Cada nível guarda a última migração; outra do mesmo nível só acontece
+ *   depois de balance ms (entre nós, raramente)
+ * - A memória do processo fica no nó do primeiro despacho: o tempo
+ *   executado em outro nó é o tráfego entre nós
+ */
+
+static long last_move_ms[TOPO_LEVELS]; // Última migração de cada nível (-1 = nenhuma)
+static TopoStats stats;
+
+/* O monoprocessador ignora a topologia */
+int topology_cpus(void) {
+#ifdef MULTI
+    const SchedTunables* t = &system_state.tunables;
+    return t->topo_nodes > 0 ? t->topo_nodes * t->topo_llcs * t->topo_cores * t->topo_smt : 0;
+#else
+    return 0;
+#endif
+}
+
+void topology_init(void) {
+    for (int level = 0; level < TOPO_LEVELS; level++) {
+        last_move_ms[level] = -1;
+    }
+    stats = (TopoStats){ 0 };
+    
+    const SchedTunables* t = &system_state.tunables;
+    if (topology_cpus() > 0) {
+        add_log_message("Topologia: %d no(s) x %d LLC x %d nucleo(s) x %d thread(s) SMT = %d CPU(s)\n",
+                        t->topo_nodes, t->topo_llcs, t->topo_cores, t->topo_smt, system_state.num_cpus);
+    }
+}
+
+int topo_node(int cpu) {
+    const SchedTunables* t = &system_state.tunables;
+    return topology_cpus() > 0 ? cpu / (t->topo_llcs * t->topo_cores * t->topo_smt) : 0;
+}
+
+TopoLevel topo_level(int a, int b) {
+    if (a == b) {
+        return TOPO_CPU;
+    }
+    if (topology_cpus() == 0) {
+        return TOPO_LLC;
+    }
+    
+    const SchedTunables* t = &system_state.tunables;
+    int per_llc = t->topo_cores * t->topo_smt;
+    if (a / t->topo_smt == b / t->topo_smt) return TOPO_SMT;
+    if (a / per_llc == b / per_llc) return TOPO_LLC;
+    if (topo_node(a) == topo_node(b)) return TOPO_NODE;
+    return TOPO_NUMA;
+}
+
+int topo_migration_cost(int last_cpu, int cpu) {
+    int cost = system_state.tunables.domain_cost_ms[topo_level(last_cpu, cpu)];
+    return cost >= 0 ? cost : system_state.tunables.migration_cost_ms;
+}
+
+bool topo_move_allowed(int last_cpu, int cpu, long now_ms) {
+    TopoLevel level = topo_level(last_cpu, cpu);
+    return last_move_ms[level] < 0 || now_ms - last_move_ms[level] >= system_state.tunables.balance_ms[level];
+}
+
+void topo_note_migration(int last_cpu, int cpu, long now_ms) {
+    TopoLevel level = topo_level(last_cpu, cpu);
+    last_move_ms[level] = now_ms;
+    stats.migrations[level]++;
+}
+
+void topo_note_deferred(void) {
+    stats.deferred++;
+}
+
+void topo_note_dispatch(PCB* pcb, int cpu, long now_ms) {
+    if (pcb->home_node < 0) {
+        pcb->home_node = topo_node(cpu);
+    }
+    pcb->on_cpu_ms = now_ms;
+}
+
+void topo_note_leave(PCB* pcb, int cpu, long now_ms) {
+    long ran = now_ms - pcb->on_cpu_ms;
+    stats.run_ms += ran;
+    if (topo_node(cpu) != pcb->home_node) {
+        stats.remote_ms += ran;
+    }
+}
+
+void topo_get_stats(TopoStats* out) {
+    *out = stats;
+}